@@ -0,0 +1,91 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "arene.h"
+#include "outils.h"
+
+#include <stddef.h>
+
+/*
+ * Taille du premier bloc d'une arène. Chaque nouveau bloc est deux fois 
+ * plus grand que le précédent, jusqu'à TAILLE_BLOC_MAX.
+ */
+#define TAILLE_BLOC_MIN 4096
+#define TAILLE_BLOC_MAX ( 1 << 20 )
+
+#define ALIGNEMENT _Alignof( max_align_t )
+
+typedef struct Bloc Bloc;
+
+struct Bloc {
+	Bloc * precedent;
+	size_t taille;
+	size_t utilise;
+	max_align_t donnees[];
+};
+
+struct Arene {
+	Bloc * bloc;
+	size_t taille_prochain_bloc;
+	size_t taille;
+};
+
+Arene* creer_arene(){
+	Arene* arene = xmalloc( sizeof(Arene) );
+	arene->bloc = NULL;
+	arene->taille_prochain_bloc = TAILLE_BLOC_MIN;
+	arene->taille = 0;
+	return arene;
+}
+
+void liberer_arene( Arene* arene ){
+	Bloc* bloc = arene->bloc;
+	while( bloc ){
+		Bloc* precedent = bloc->precedent;
+		xfree( bloc );
+		bloc = precedent;
+	}
+	xfree( arene );
+}
+
+void* allouer_arene( Arene* arene, size_t taille ){
+	taille = ( taille + ALIGNEMENT - 1 ) / ALIGNEMENT * ALIGNEMENT;
+	Bloc* bloc = arene->bloc;
+	if( ! bloc || bloc->taille - bloc->utilise < taille ){
+		size_t taille_bloc = arene->taille_prochain_bloc;
+		if( taille_bloc < taille ) taille_bloc = taille;
+		bloc = xmalloc( sizeof(Bloc) + taille_bloc );
+		bloc->precedent = arene->bloc;
+		bloc->taille = taille_bloc;
+		bloc->utilise = 0;
+		arene->bloc = bloc;
+		if( arene->taille_prochain_bloc < TAILLE_BLOC_MAX ){
+			arene->taille_prochain_bloc *= 2;
+		}
+	}
+	void* res = (char*) bloc->donnees + bloc->utilise;
+	bloc->utilise += taille;
+	arene->taille += taille;
+	return res;
+}
+
+size_t taille_arene( const Arene* arene ){
+	return arene->taille;
+}
@@ -0,0 +1,55 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __ARENE_H__
+#define __ARENE_H__
+
+#include <stddef.h>
+
+/*
+ * Définit le type d'une arène : une zone mémoire dans laquelle on alloue 
+ * des objets les uns à la suite des autres, et que l'on libère d'un seul
+ * coup. Les objets d'une arène ne sont jamais libérés individuellement.
+ */
+typedef struct Arene Arene;
+
+/*
+ * Crée une arène vide.
+ */
+Arene* creer_arene();
+
+/*
+ * Libère l'arène et tous les objets qui y ont été alloués.
+ */
+void liberer_arene( Arene* arene );
+
+/*
+ * Alloue 'taille' octets dans l'arène. La mémoire renvoyée est alignée 
+ * pour n'importe quel type et reste valide jusqu'à la libération de 
+ * l'arène.
+ */
+void* allouer_arene( Arene* arene, size_t taille );
+
+/*
+ * Renvoie le nombre d'octets alloués dans l'arène.
+ */
+size_t taille_arene( const Arene* arene );
+
+#endif
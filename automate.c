@@ -23,7 +23,10 @@
 #include "ensemble.h"
 #include "outils.h"
 #include "fifo.h"
+#include "dictionnaire.h"
+#include "automate_bits.h"
 
+#include <stdatomic.h>
 #include <search.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -32,7 +35,6 @@
 
 #include <assert.h>
 
-#include <math.h>
 
 void action_get_max_etat( const intptr_t element, void* data ){
 	int * max = (int*) data;
@@ -108,11 +110,38 @@ Automate * creer_automate(){
 	automate->initiaux = creer_ensemble( NULL, NULL, NULL );
 	automate->finaux = creer_ensemble( NULL, NULL, NULL );
 	automate->vide = creer_ensemble( NULL, NULL, NULL ); 
+	automate->simulation = NULL;
+	automate->simulable = 0;
+	automate->adjacence = NULL;
+	automate->adjacence_inverse = NULL;
 	return automate;
 }
 
+static void liberer_adjacence( Adjacence* adjacence );
+
+/*
+ * Toute modification de l'automate rend sa simulation bit à bit et ses 
+ * index d'adjacence obsolètes.
+ */
+static void invalider_automate( Automate * automate ){
+	if( automate->simulation ){
+		liberer_automate_bits( automate->simulation );
+		automate->simulation = NULL;
+	}
+	automate->simulable = 0;
+	if( automate->adjacence ){
+		liberer_adjacence( automate->adjacence );
+		automate->adjacence = NULL;
+	}
+	if( automate->adjacence_inverse ){
+		liberer_adjacence( automate->adjacence_inverse );
+		automate->adjacence_inverse = NULL;
+	}
+}
+
 void liberer_automate( Automate * automate ){
 	assert( automate );
+	invalider_automate( automate );
 	liberer_ensemble( automate->vide );
 	liberer_ensemble( automate->finaux );
 	liberer_ensemble( automate->initiaux );
@@ -142,10 +171,12 @@ const Ensemble * get_alphabet( const Automate* automate ){
 }
 
 void ajouter_etat( Automate * automate, int etat ){
+	invalider_automate( automate );
 	ajouter_element( automate->etats, etat );
 }
 
 void ajouter_lettre( Automate * automate, char lettre ){
+	invalider_automate( automate );
 	ajouter_element( automate->alphabet, lettre );
 }
 
@@ -155,6 +186,7 @@ void ajouter_transition(
 	ajouter_etat( automate, origine );
 	ajouter_etat( automate, fin );
 	ajouter_lettre( automate, lettre );
+	invalider_automate( automate );
 
 	Cle cle;
 	initialiser_cle( &cle, origine, lettre );
@@ -173,6 +205,7 @@ void ajouter_etat_final(
 	Automate * automate, int etat_final
 ){
 	ajouter_etat( automate, etat_final );
+	invalider_automate( automate );
 	ajouter_element( automate->finaux, etat_final );
 }
 
@@ -180,6 +213,7 @@ void ajouter_etat_initial(
 	Automate * automate, int etat_initial
 ){
 	ajouter_etat( automate, etat_initial );
+	invalider_automate( automate );
 	ajouter_element( automate->initiaux, etat_initial );
 }
 
@@ -194,9 +228,54 @@ const Ensemble * voisins( const Automate* automate, int origine, char lettre ){
 	}
 }
 
+/*
+ * La simulation est construite à la première lecture d'un mot, et non par 
+ * Glushkov() : un automate qui n'est que déterminisé ou combiné à d'autres
+ * n'en a jamais besoin. Elle est publiée comme les index d'adjacence.
+ */
+const Automate_bits* simulation_automate( const Automate* automate ){
+	Automate_bits* res = atomic_load( &automate->simulation );
+	if( res || ! atomic_load( &automate->simulable ) ){
+		return res;
+	}
+	Automate_bits* nouvelle = creer_automate_bits( automate );
+	if( ! nouvelle ){
+		atomic_store( &( (Automate*) automate )->simulable, 0 );
+		return NULL;
+	}
+	if( 
+		atomic_compare_exchange_strong( 
+			&( (Automate*) automate )->simulation, &res, nouvelle 
+		) 
+	){
+		return nouvelle;
+	}
+	liberer_automate_bits( nouvelle );
+	return res;
+}
+
+/*
+ * Calcule delta_star avec la simulation bit à bit de l'automate.
+ */
+static Ensemble * delta_star_simulation(
+	const Automate_bits* simulation, const Ensemble * etats_courants, 
+	const char* mot, size_t longueur
+){
+	uint64_t etats[ AUTOMATE_BITS_MAX_ETATS / 64 ];
+	ensemble_vers_bits( simulation, etats_courants, etats );
+	delta_star_bits( simulation, etats, mot, longueur );
+	return bits_vers_ensemble( simulation, etats );
+}
+
 Ensemble * delta(
 	const Automate* automate, const Ensemble * etats_courants, char lettre
 ){
+	// Une seule lettre ne justifie pas de construire la simulation : 
+	// delta() ne s'en sert que si elle existe déjà.
+	const Automate_bits* simulation = atomic_load( &automate->simulation );
+	if( simulation ){
+		return delta_star_simulation( simulation, etats_courants, &lettre, 1 );
+	}
 	Ensemble * res = creer_ensemble( NULL, NULL, NULL );
 
 	Ensemble_iterateur it;
@@ -218,6 +297,10 @@ Ensemble * delta_star(
 	const Automate* automate, const Ensemble * etats_courants, const char* mot
 ){
 	int len = strlen( mot );
+	const Automate_bits* simulation = simulation_automate( automate );
+	if( simulation ){
+		return delta_star_simulation( simulation, etats_courants, mot, len );
+	}
 	int i;
 	Ensemble * old = copier_ensemble( etats_courants );
 	Ensemble * new = old;
@@ -313,185 +396,213 @@ Automate* copier_automate( const Automate* automate ){
 }
 
 /*
- *                         x = 0
- *                          |
- *                          V
- * 
- * 283 237 195 157 123  93  67  91 119 151 187 227 271 
- * 238 196 158 124  94  68  46  66  90 118 150 186 226 
- * 197 159 125  95  69  47  29  45  65  89 117 149 185 
- * 160 126  96  70  48  30  16  28  44  64  88 116 148 
- * 127  97  71  49  31  17   7  15  27  43  63  87 115 
- *  98  72  50  32  18   8   2   6  14  26  42  62  86 
- *  73  51  33  19   9   3   0   1   5  13  25  41  61  <- y = 0
- * 100  74  52  34  20  10   4  12  24  40  60  84 112 
- * 131 101  75  53  35  21  11  23  39  59  83 111 143 
- * 166 132 102  76  54  36  22  38  58  82 110 142 178 
- * 205 167 133 103  77  55  37  57  81 109 141 177 217 
- * 248 206 168 134 104  78  56  80 108 140 176 216 260 
- * 295 249 207 169 135 105  79 107 139 175 215 259 307
- * 
+ * Table de hachage qui associe à un couple d'états (q1, q2) son numéro 
+ * dans l'automate produit. Elle est à adressage ouvert et sa taille, une 
+ * puissance de 2, double dès qu'elle est à moitié pleine.
+ *
+ * Les couples sont numérotés dans l'ordre de leur découverte, à partir 
+ * de 0 : les couples premiers[i], seconds[i] servent aussi de file pour 
+ * le parcours en largeur.
  */
-int couple_to_int( int q1, int q2 ){
-	if(q1==0 && q2==0) return 0;
-	int sum = abs(q1) + abs(q2);
-	int prev = 2*sum*(sum-1);
-	if( q1 > 0 && q2 >= 0 ) return prev + 1 + q2;
-	if( q1 <= 0 && q2 > 0 ) return prev + sum+1 + (-q1);
-	if( q1 < 0 && q2 <= 0 ) return prev + 2*sum+ 1 + (-q2);
-	return prev + 3*sum+ 1 + q1; //cas q1>=0 && q2<0 
-}
-
-void int_to_couple( int entree, int * q1, int * q2 ){
-	if( entree == 0 ){
-		*q1 = 0;
-		*q2 = 0;
-		return;
-	}
-	entree -= 1;
-	int sum = (int) floor( ( 1+ sqrt( 1 + 2.0*entree ) )/2.0 );
-	int couche = entree - 2*sum*(sum-1);
-	int r = couche % sum;
-	int s = sum-r;
-	switch( couche/sum ){ 
-		case 0:
-			*q2=r;
-			*q1=s;
-			break;
-		case 1:
-			*q1=-r;
-			*q2=s;
-			break;
-		case 2:
-			*q2 = -r;
-			*q1=-s;
-			break;
-		case 3:
-			*q1 = r;
-			*q2=-s;
-			break;
-		default:
-			ERREUR("Impossible !");
+typedef struct {
+	int nb_couples;
+	int capacite;
+	int* premiers;
+	int* seconds;
+	int taille;
+	int* alveoles;
+} Table_couples;
+
+static unsigned int hacher_couple( int q1, int q2 ){
+	uint64_t h = ( (uint64_t) (uint32_t) q1 << 32 ) | (uint32_t) q2;
+	h ^= h >> 33;
+	h *= 0xff51afd7ed558ccdULL;
+	h ^= h >> 33;
+	return (unsigned int) h;
+}
+
+static void initialiser_table_couples( Table_couples* table ){
+	table->nb_couples = 0;
+	table->capacite = 16;
+	table->premiers = xmalloc( table->capacite * sizeof(int) );
+	table->seconds = xmalloc( table->capacite * sizeof(int) );
+	table->taille = 32;
+	table->alveoles = xmalloc( table->taille * sizeof(int) );
+	memset( table->alveoles, -1, table->taille * sizeof(int) );
+}
+
+static void detruire_table_couples( Table_couples* table ){
+	xfree( table->premiers );
+	xfree( table->seconds );
+	xfree( table->alveoles );
+}
+
+static void agrandir_table_couples( Table_couples* table ){
+	int i;
+	xfree( table->alveoles );
+	table->taille *= 2;
+	table->alveoles = xmalloc( table->taille * sizeof(int) );
+	memset( table->alveoles, -1, table->taille * sizeof(int) );
+	for( i = 0; i < table->nb_couples; i++ ){
+		unsigned int h = hacher_couple( table->premiers[i], table->seconds[i] );
+		while( table->alveoles[ h & ( table->taille - 1 ) ] >= 0 ) h++;
+		table->alveoles[ h & ( table->taille - 1 ) ] = i;
+	}
+}
+
+/*
+ * Renvoie le numéro du couple (q1, q2), en l'ajoutant s'il est nouveau.
+ */
+static int numero_couple( Table_couples* table, int q1, int q2, int* nouveau ){
+	unsigned int h = hacher_couple( q1, q2 );
+	int i;
+	for( ;; h++ ){
+		i = table->alveoles[ h & ( table->taille - 1 ) ];
+		if( i < 0 ) break;
+		if( table->premiers[i] == q1 && table->seconds[i] == q2 ){
+			*nouveau = 0;
+			return i;
+		}
+	}
+	i = table->nb_couples++;
+	if( i == table->capacite ){
+		table->capacite *= 2;
+		table->premiers = xrealloc( table->premiers, table->capacite * sizeof(int) );
+		table->seconds = xrealloc( table->seconds, table->capacite * sizeof(int) );
 	}
+	table->premiers[i] = q1;
+	table->seconds[i] = q2;
+	table->alveoles[ h & ( table->taille - 1 ) ] = i;
+	if( 2 * table->nb_couples > table->taille ){
+		agrandir_table_couples( table );
+	}
+	*nouveau = 1;
+	return i;
 }
 
 Automate * creer_intersection_des_automates(
 	const Automate * automate_1, const Automate * automate_2
 ){
 	Automate * res = creer_automate();
+	Table_couples couples;
+	initialiser_table_couples( &couples );
+	int nouveau;
+
+	// Les couples sont des couples de numéros d'états dans les index.
+	const Adjacence * adj_1 = adjacence_automate( automate_1 );
+	const Adjacence * adj_2 = adjacence_automate( automate_2 );
 
-	// On engendre tous les couples et on les ajoute dans l'automate
 	Ensemble_iterateur it_etat_1;
 	Ensemble_iterateur it_etat_2;
 	Ensemble_iterateur it_lettre;
+
+	// L'alphabet du produit est l'union des alphabets.
 	for(
-		it_etat_1 = premier_iterateur_ensemble( get_etats( automate_1 ) );
-		! iterateur_ensemble_est_vide( it_etat_1 );
-		it_etat_1 = iterateur_suivant_ensemble( it_etat_1 )
+		it_lettre = premier_iterateur_ensemble( get_alphabet( automate_1 ) );
+		! iterateur_ensemble_est_vide( it_lettre );
+		it_lettre = iterateur_suivant_ensemble( it_lettre )
 	){
-		int q1 = get_element( it_etat_1 );
-		for(
-			it_etat_2 = premier_iterateur_ensemble( get_etats( automate_2 ) );
-			! iterateur_ensemble_est_vide( it_etat_2 );
-			it_etat_2 = iterateur_suivant_ensemble( it_etat_2 )
-		){
-			int q2 = get_element( it_etat_2 );
-			ajouter_etat( res, couple_to_int( q1, q2 ) );
-		}
+		ajouter_lettre( res, get_element( it_lettre ) );
+	}
+	for(
+		it_lettre = premier_iterateur_ensemble( get_alphabet( automate_2 ) );
+		! iterateur_ensemble_est_vide( it_lettre );
+		it_lettre = iterateur_suivant_ensemble( it_lettre )
+	){
+		ajouter_lettre( res, get_element( it_lettre ) );
 	}
 
-	// On engendre tous les couples d'états initiaux :
+	// Les couples d'états initiaux :
 	for(
 		it_etat_1 = premier_iterateur_ensemble( get_initiaux( automate_1 ) );
 		! iterateur_ensemble_est_vide( it_etat_1 );
 		it_etat_1 = iterateur_suivant_ensemble( it_etat_1 )
 	){
-		int q1 = get_element( it_etat_1 );
+		int q1 = numero_etat( adj_1, get_element( it_etat_1 ) );
 		for(
 			it_etat_2 = premier_iterateur_ensemble( get_initiaux( automate_2 ) );
 			! iterateur_ensemble_est_vide( it_etat_2 );
 			it_etat_2 = iterateur_suivant_ensemble( it_etat_2 )
 		){
-			int q2 = get_element( it_etat_2 );
+			int q2 = numero_etat( adj_2, get_element( it_etat_2 ) );
 			ajouter_etat_initial( 
-				res, couple_to_int( q1, q2 )
+				res, numero_couple( &couples, q1, q2, &nouveau )
 			);
 		}
 	}
 
-	// On engendre tous les couples d'états finaux :
-	for(
-		it_etat_1 = premier_iterateur_ensemble( get_finaux( automate_1 ) );
-		! iterateur_ensemble_est_vide( it_etat_1 );
-		it_etat_1 = iterateur_suivant_ensemble( it_etat_1 )
-	){
-		int q1 = get_element( it_etat_1 );
-		for(
-			it_etat_2 = premier_iterateur_ensemble( get_finaux( automate_2 ) );
-			! iterateur_ensemble_est_vide( it_etat_2 );
-			it_etat_2 = iterateur_suivant_ensemble( it_etat_2 )
-		){
-			int q2 = get_element( it_etat_2 );
-			ajouter_etat_final( 
-				res, couple_to_int( q1, q2 )
-			);			
-		}
+	// Les lettres d'une même classe mènent aux mêmes couples : les 
+	// couples d'arrivée ne sont cherchés que pour le représentant de la 
+	// classe, puis la transition est recopiée pour les autres lettres.
+	uint16_t classes[256];
+	char representants[257];
+	int nb_classes = classes_de_lettres_communes( 
+		automate_1, automate_2, classes, representants 
+	);
+	int debut_classe[258];
+	char membres[256];
+	int o;
+	memset( debut_classe, 0, sizeof(debut_classe) );
+	for( o = 0; o < 256; o++ ){
+		if( classes[o] ) debut_classe[ classes[o] + 1 ]++;
 	}
-
-	// On engendre l'alphabet :
-	for(
-		it_lettre = premier_iterateur_ensemble( get_alphabet( automate_1 ) );
-		! iterateur_ensemble_est_vide( it_lettre );
-		it_lettre = iterateur_suivant_ensemble( it_lettre )
-	){
-		char lettre = get_element( it_lettre );
-		ajouter_lettre( res, lettre );
+	for( o = 0; o < nb_classes; o++ ){
+		debut_classe[o+1] += debut_classe[o];
 	}
-	for(
-		it_lettre = premier_iterateur_ensemble( get_alphabet( automate_2 ) );
-		! iterateur_ensemble_est_vide( it_lettre );
-		it_lettre = iterateur_suivant_ensemble( it_lettre )
-	){
-		char lettre = get_element( it_lettre );
-		ajouter_lettre( res, lettre );
+	int remplissage[257];
+	memcpy( remplissage, debut_classe, sizeof(remplissage) );
+	for( o = 0; o < 256; o++ ){
+		if( classes[o] ) membres[ remplissage[ classes[o] ]++ ] = (char) o;
 	}
 
-	// On engendre les transitions :
-	Ensemble_iterateur it_etat;
-	for(
-		it_etat = premier_iterateur_ensemble( get_etats( res ) );
-		! iterateur_ensemble_est_vide( it_etat );
-		it_etat = iterateur_suivant_ensemble( it_etat )
-	){
-		int q = get_element( it_etat );
-		int o1 , o2, e1, e2;
-		int_to_couple( q, &o1, &o2 );
-		for(
-			it_lettre = premier_iterateur_ensemble( get_alphabet( res ) );
-			! iterateur_ensemble_est_vide( it_lettre );
-			it_lettre = iterateur_suivant_ensemble( it_lettre )
+	// Parcours en largeur des couples accessibles. Les transitions de 
+	// chaque état étant triées par lettre, celles des deux états d'un 
+	// couple sont fusionnées comme deux listes triées.
+	int q;
+	for( q = 0; q < couples.nb_couples; q++ ){
+		int o1 = couples.premiers[q];
+		int o2 = couples.seconds[q];
+		ajouter_etat( res, q );
+		if( 
+			est_un_etat_final_de_l_automate( automate_1, adj_1->etats[o1] )
+			&& est_un_etat_final_de_l_automate( automate_2, adj_2->etats[o2] )
 		){
-			char lettre = get_element( it_lettre );
-			const Ensemble * v1 = voisins( automate_1, o1, lettre );
-			const Ensemble * v2 = voisins( automate_2, o2, lettre );
-			for(
-				it_etat_1 = premier_iterateur_ensemble( v1 );
-				! iterateur_ensemble_est_vide( it_etat_1 );
-				it_etat_1 = iterateur_suivant_ensemble( it_etat_1 )
-			){
-				e1 = get_element( it_etat_1 );
-				for(
-					it_etat_2 = premier_iterateur_ensemble( v2 );
-					! iterateur_ensemble_est_vide( it_etat_2 );
-					it_etat_2 = iterateur_suivant_ensemble( it_etat_2 )
-				){
-					e2 = get_element( it_etat_2 );
-					ajouter_transition( res, q, lettre, couple_to_int(e1,e2) );
+			ajouter_etat_final( res, q );
+		}
+		int i = adj_1->debut[o1], fin_1 = adj_1->debut[o1+1];
+		int j = adj_2->debut[o2], fin_2 = adj_2->debut[o2+1];
+		while( i < fin_1 && j < fin_2 ){
+			char lettre = adj_1->lettres[i];
+			if( lettre < adj_2->lettres[j] ){
+				i++;
+				continue;
+			}
+			if( lettre > adj_2->lettres[j] ){
+				j++;
+				continue;
+			}
+			int i_fin = i, j_fin = j, k, l;
+			while( i_fin < fin_1 && adj_1->lettres[i_fin] == lettre ) i_fin++;
+			while( j_fin < fin_2 && adj_2->lettres[j_fin] == lettre ) j_fin++;
+			int c = classes[ (unsigned char) lettre ];
+			if( representants[c] == lettre ){
+				for( k = i; k < i_fin; k++ ){
+					for( l = j; l < j_fin; l++ ){
+						int cible = numero_couple( 
+							&couples, adj_1->voisins[k], adj_2->voisins[l], &nouveau 
+						);
+						for( o = debut_classe[c]; o < debut_classe[c+1]; o++ ){
+							ajouter_transition( res, q, membres[o], cible );
+						}
+					}
 				}
 			}
+			i = i_fin;
+			j = j_fin;
 		}
 	}
 
+	detruire_table_couples( &couples );
 	return res;
 }
 
@@ -522,87 +633,279 @@ int etat_maximal( const Automate * automate ){
 	return max;
 }
 
-Ensemble* etats_accessibles( const Automate * automate, int etat ){
-	Ensemble * resultat = creer_ensemble( NULL, NULL, NULL );
-	Ensemble * courants = creer_ensemble( NULL, NULL, NULL );
-	ajouter_element( resultat, etat );
-	ajouter_elements( courants, resultat );
+int numero_etat( const Adjacence* adjacence, int etat ){
+	if( adjacence->numeros ){
+		unsigned int i = (unsigned int) etat - (unsigned int) adjacence->etats[0];
+		return i < (unsigned int) adjacence->nb_numeros ? adjacence->numeros[i] : -1;
+	}
+	int bas = 0, haut = adjacence->nb_etats - 1;
+	while( bas <= haut ){
+		int milieu = bas + ( haut - bas ) / 2;
+		if( adjacence->etats[milieu] < etat ) bas = milieu + 1;
+		else if( adjacence->etats[milieu] > etat ) haut = milieu - 1;
+		else return milieu;
+	}
+	return -1;
+}
 
-	int n = taille_ensemble( get_etats( automate ) );
-	int i;
+/*
+ * La table des transitions est parcourue deux fois, par 
+ * pour_toute_cle_valeur_table() : une fois pour compter les transitions 
+ * de chaque état, une fois pour les ranger.
+ */
+typedef struct {
+	Adjacence* adjacence;
+	int inverse;
+	int* positions;
+	int origine;
+	char lettre;
+} data_creer_adjacence;
+
+static void action_compter_adjacence( const intptr_t element, void* data ){
+	data_creer_adjacence* d = (data_creer_adjacence*) data;
+	d->adjacence->debut[ numero_etat( d->adjacence, element ) + 1 ]++;
+}
 
-	Ensemble* tmp;
-	Ensemble* next;
+static void action_ranger_adjacence( const intptr_t element, void* data ){
+	data_creer_adjacence* d = (data_creer_adjacence*) data;
+	Adjacence* adjacence = d->adjacence;
+	int fin = numero_etat( adjacence, element );
+	int j;
+	if( d->inverse ){
+		j = d->positions[fin]++;
+		adjacence->voisins[j] = d->origine;
+	}else{
+		j = d->positions[ d->origine ]++;
+		adjacence->voisins[j] = fin;
+	}
+	adjacence->lettres[j] = d->lettre;
+}
 
-	for( i=0; i< n-1; i++ ){
+static void action_transitions_adjacence( 
+	const intptr_t cle, intptr_t valeur, void* data 
+){
+	data_creer_adjacence* d = (data_creer_adjacence*) data;
+	const Cle* c = (const Cle*) cle;
+	Ensemble* fins = (Ensemble*) valeur;
+	Adjacence* adjacence = d->adjacence;
+	if( d->positions == NULL ){
+		if( d->inverse ){
+			pour_tout_element( fins, action_compter_adjacence, d );
+		}else{
+			adjacence->debut[ numero_etat( adjacence, c->origine ) + 1 ] += 
+				taille_ensemble( fins );
+		}
+	}else{
+		d->origine = numero_etat( adjacence, c->origine );
+		d->lettre = (char) c->lettre;
+		pour_tout_element( fins, action_ranger_adjacence, d );
+	}
+}
 
-		next = creer_ensemble( NULL, NULL, NULL );
+static Adjacence* creer_adjacence( const Automate* automate, int inverse ){
+	Adjacence* adjacence = xmalloc( sizeof(Adjacence) );
+	Ensemble_iterateur it;
+	int i;
+	int n = taille_ensemble( get_etats( automate ) );
 
-		Ensemble_iterateur it;
-		for( 
-			it = premier_iterateur_ensemble( get_alphabet( automate ) );
-			! iterateur_ensemble_est_vide( it );
-			it = iterateur_suivant_ensemble( it )
-		){
-			tmp = delta( automate, courants, get_element(it) );
-			ajouter_elements( next, tmp );
-			liberer_ensemble( tmp );
+	adjacence->nb_etats = n;
+	adjacence->etats = xmalloc( ( n + 1 ) * sizeof(int) );
+	adjacence->debut = xmalloc( ( n + 1 ) * sizeof(int) );
+	i = 0;
+	for(
+		it = premier_iterateur_ensemble( get_etats( automate ) );
+		! iterateur_ensemble_est_vide( it );
+		it = iterateur_suivant_ensemble( it )
+	){
+		adjacence->etats[i++] = get_element( it );
+	}
+	memset( adjacence->debut, 0, ( n + 1 ) * sizeof(int) );
+
+	// Si les états sont presque consécutifs, leurs numéros sont rangés 
+	// dans un tableau plutôt que cherchés par dichotomie.
+	adjacence->numeros = NULL;
+	adjacence->nb_numeros = 0;
+	if( n > 0 && (long) adjacence->etats[n-1] - adjacence->etats[0] < 2L * n ){
+		adjacence->nb_numeros = adjacence->etats[n-1] - adjacence->etats[0] + 1;
+		adjacence->numeros = xmalloc( adjacence->nb_numeros * sizeof(int) );
+		memset( adjacence->numeros, -1, adjacence->nb_numeros * sizeof(int) );
+		for( i = 0; i < n; i++ ){
+			adjacence->numeros[ adjacence->etats[i] - adjacence->etats[0] ] = i;
 		}
+	}
 
-		ajouter_elements( resultat, next );
-		liberer_ensemble( courants );
-		courants = next;
+	data_creer_adjacence data;
+	data.adjacence = adjacence;
+	data.inverse = inverse;
+	data.positions = NULL;
+	pour_toute_cle_valeur_table( 
+		automate->transitions, action_transitions_adjacence, &data 
+	);
+	for( i = 0; i < n; i++ ){
+		adjacence->debut[i+1] += adjacence->debut[i];
 	}
-	
-	liberer_ensemble( courants );
+	int m = adjacence->debut[n];
+	adjacence->nb_transitions = m;
+
+	// La table étant parcourue dans l'ordre des clés, l'ordre des 
+	// transitions de chaque état est stable.
+	adjacence->lettres = xmalloc( m + 1 );
+	adjacence->voisins = xmalloc( ( m + 1 ) * sizeof(int) );
+	data.positions = xmalloc( ( n + 1 ) * sizeof(int) );
+	memcpy( data.positions, adjacence->debut, ( n + 1 ) * sizeof(int) );
+	pour_toute_cle_valeur_table( 
+		automate->transitions, action_transitions_adjacence, &data 
+	);
+	xfree( data.positions );
+	return adjacence;
+}
 
-        return resultat;
+static void liberer_adjacence( Adjacence* adjacence ){
+	if( adjacence ){
+		xfree( adjacence->etats );
+		xfree( adjacence->numeros );
+		xfree( adjacence->debut );
+		xfree( adjacence->lettres );
+		xfree( adjacence->voisins );
+		xfree( adjacence );
+	}
 }
 
-Ensemble* accessibles( const Automate * automate ){
-	Ensemble_iterateur it1;
-	Ensemble * access = creer_ensemble( NULL, NULL, NULL );
-	for(
-		it1 = premier_iterateur_ensemble( get_initiaux( automate ) );
-		! iterateur_ensemble_est_vide( it1 );
-		it1 = iterateur_suivant_ensemble( it1 )
-	){
-		Ensemble * ens = etats_accessibles( automate, get_element(it1) );
-		ajouter_elements( access, ens );
-		liberer_ensemble( ens );
+/*
+ * Les index font partie du cache de l'automate : ils sont construits à la 
+ * première demande, même sur un automate constant, et détruits par 
+ * invalider_automate(). Si plusieurs fils construisent le même index en 
+ * même temps, le premier à le publier gagne et les autres libèrent leur 
+ * copie.
+ */
+static const Adjacence* publier_adjacence(
+	Adjacence * _Atomic * cache, const Automate* automate, int inverse
+){
+	Adjacence* res = atomic_load( cache );
+	if( res ){
+		return res;
+	}
+	Adjacence* nouvelle = creer_adjacence( automate, inverse );
+	if( atomic_compare_exchange_strong( cache, &res, nouvelle ) ){
+		return nouvelle;
 	}
-	return access;
+	liberer_adjacence( nouvelle );
+	return res;
 }
 
-Automate *automate_accessible( const Automate * automate ){
-	Automate * res = creer_automate();
-	Ensemble_iterateur it1;
+const Adjacence* adjacence_automate( const Automate* automate ){
+	return publier_adjacence( 
+		&( (Automate*) automate )->adjacence, automate, 0
+	);
+}
 
-	Ensemble * access = accessibles( automate );
+const Adjacence* adjacence_inverse_automate( const Automate* automate ){
+	return publier_adjacence(
+		&( (Automate*) automate )->adjacence_inverse, automate, 1
+	);
+}
 
-	// On ajoute les états de l'automate
+/*
+ * Parcourt l'automate depuis toutes les sources à la fois, avec une liste
+ * de travail et un tableau de bits des états déjà vus. Chaque état et 
+ * chaque transition ne sont donc examinés qu'une fois. Renvoie l'ensemble
+ * des états atteints, sources comprises.
+ */
+static Ensemble* parcourir_adjacence( 
+	const Adjacence* adjacence, const Ensemble* sources 
+){
+	int n = adjacence->nb_etats;
+	size_t nb_mots = n / 64 + 1;
+	uint64_t* vus = xmalloc( nb_mots * sizeof(uint64_t) );
+	memset( vus, 0, nb_mots * sizeof(uint64_t) );
+	int* travail = xmalloc( ( n + 1 ) * sizeof(int) );
+	int nb_travail = 0;
+	int i, j;
+
+	Ensemble_iterateur it;
 	for(
-		it1 = premier_iterateur_ensemble( access );
-		! iterateur_ensemble_est_vide( it1 );
-		it1 = iterateur_suivant_ensemble( it1 )
+		it = premier_iterateur_ensemble( sources );
+		! iterateur_ensemble_est_vide( it );
+		it = iterateur_suivant_ensemble( it )
 	){
-		ajouter_etat( res, get_element( it1 ) );
+		i = numero_etat( adjacence, get_element( it ) );
+		if( i >= 0 && ! ( vus[ i / 64 ] >> ( i % 64 ) & 1 ) ){
+			vus[ i / 64 ] |= (uint64_t) 1 << ( i % 64 );
+			travail[ nb_travail++ ] = i;
+		}
 	}
-	// On ajoute les états initiaux
-	for(
-		it1 = premier_iterateur_ensemble( get_initiaux( automate ) );
-		! iterateur_ensemble_est_vide( it1 );
-		it1 = iterateur_suivant_ensemble( it1 )
-	){
-		ajouter_etat_initial( res, get_element( it1 ) );
+	while( nb_travail > 0 ){
+		i = travail[ --nb_travail ];
+		for( j = adjacence->debut[i]; j < adjacence->debut[i+1]; j++ ){
+			int v = adjacence->voisins[j];
+			if( ! ( vus[ v / 64 ] >> ( v % 64 ) & 1 ) ){
+				vus[ v / 64 ] |= (uint64_t) 1 << ( v % 64 );
+				travail[ nb_travail++ ] = v;
+			}
+		}
 	}
-	// On ajoute les états finaux
+
+	Ensemble * res = creer_ensemble( NULL, NULL, NULL );
+	for( i = 0; i < n; i++ ){
+		if( vus[ i / 64 ] >> ( i % 64 ) & 1 ){
+			ajouter_element( res, adjacence->etats[i] );
+		}
+	}
+	xfree( travail );
+	xfree( vus );
+	return res;
+}
+
+static Ensemble* parcourir_automate( 
+	const Automate * automate, const Ensemble* sources, int inverse 
+){
+	return parcourir_adjacence( 
+		inverse ? adjacence_inverse_automate( automate ) 
+			: adjacence_automate( automate ),
+		sources
+	);
+}
+
+Ensemble* etats_accessibles( const Automate * automate, int etat ){
+	Ensemble * source = creer_ensemble( NULL, NULL, NULL );
+	ajouter_element( source, etat );
+	Ensemble * res = parcourir_automate( automate, source, 0 );
+	// L'état de départ est accessible même s'il n'est pas un état de 
+	// l'automate.
+	ajouter_element( res, etat );
+	liberer_ensemble( source );
+	return res;
+}
+
+Ensemble* accessibles( const Automate * automate ){
+	return parcourir_automate( automate, get_initiaux( automate ), 0 );
+}
+
+Ensemble* coaccessibles( const Automate * automate ){
+	return parcourir_automate( automate, get_finaux( automate ), 1 );
+}
+
+/*
+ * Renvoie l'automate restreint aux états de l'ensemble passé en 
+ * paramètre. L'alphabet est conservé.
+ */
+static Automate *restreindre_automate( 
+	const Automate * automate, const Ensemble * etats 
+){
+	Automate * res = creer_automate();
+	Ensemble_iterateur it1;
+
+	// On ajoute les états de l'automate
 	for(
-		it1 = premier_iterateur_ensemble( access );
+		it1 = premier_iterateur_ensemble( etats );
 		! iterateur_ensemble_est_vide( it1 );
 		it1 = iterateur_suivant_ensemble( it1 )
 	){
 		int etat = get_element( it1 );
+		ajouter_etat( res, etat );
+		if( est_un_etat_initial_de_l_automate( automate, etat ) ){
+			ajouter_etat_initial( res, etat );
+		}
 		if( est_un_etat_final_de_l_automate( automate, etat ) ){
 			ajouter_etat_final( res, etat );
 		}
@@ -625,7 +928,7 @@ Automate *automate_accessible( const Automate * automate ){
 		Cle * cle = (Cle*) get_cle( it2 );
 		int origine = cle->origine; 
 		char lettre = cle->lettre;
-		if( est_dans_l_ensemble( access, origine ) ){ 
+		if( est_dans_l_ensemble( etats, origine ) ){ 
 			Ensemble * fins = (Ensemble*) get_valeur( it2 );
 			for(
 				it1 = premier_iterateur_ensemble( fins );
@@ -633,11 +936,30 @@ Automate *automate_accessible( const Automate * automate ){
 				it1 = iterateur_suivant_ensemble( it1 )
 			){
 				int fin = get_element( it1 );
-				ajouter_transition( res, origine, lettre, fin );
+				if( est_dans_l_ensemble( etats, fin ) ){
+					ajouter_transition( res, origine, lettre, fin );
+				}
 			}
 		}
-	};
+	}
+	return res;
+}
+
+Automate *automate_accessible( const Automate * automate ){
+	Ensemble * access = accessibles( automate );
+	Automate * res = restreindre_automate( automate, access );
+	liberer_ensemble( access );
+	return res;
+}
+
+Automate *automate_emonde( const Automate * automate ){
+	Ensemble * access = accessibles( automate );
+	Ensemble * coaccess = coaccessibles( automate );
+	Ensemble * utiles = creer_intersection_ensemble( access, coaccess );
+	Automate * res = restreindre_automate( automate, utiles );
 	liberer_ensemble( access );
+	liberer_ensemble( coaccess );
+	liberer_ensemble( utiles );
 	return res;
 }
 
@@ -770,6 +1092,10 @@ void print_automate( const Automate * automate ){
 }
 
 int le_mot_est_reconnu( const Automate* automate, const char* mot ){
+	const Automate_bits* simulation = simulation_automate( automate );
+	if( simulation ){
+		return le_mot_est_reconnu_bits( simulation, mot, strlen( mot ) );
+	}
 	Ensemble * arrivee = delta_star( automate, get_initiaux(automate) , mot ); 
 	
 	int result = 0;
@@ -789,44 +1115,223 @@ int le_mot_est_reconnu( const Automate* automate, const char* mot ){
 	return result;
 }
 
-int ajouter_ensemble( 
-	const Ensemble* ens,
-	Table* ensemble_to_id, Table* id_to_ensemble, Fifo* f, 
-	Automate * aut, int next_id
+/*
+ * Une lettre lue depuis un état : sa classe courante, le hachage de ses 
+ * états d'arrivée, et ses transitions dans l'index, de debut à fin.
+ */
+typedef struct {
+	int classe;
+	uint64_t hachage;
+	int debut;
+	int fin;
+} Lettre_lue;
+
+static int comparer_lettres_lues( const void* a, const void* b ){
+	const Lettre_lue* x = (const Lettre_lue*) a;
+	const Lettre_lue* y = (const Lettre_lue*) b;
+	if( x->classe != y->classe ) return x->classe < y->classe ? -1 : 1;
+	if( x->hachage != y->hachage ) return x->hachage < y->hachage ? -1 : 1;
+	return 0;
+}
+
+/*
+ * Raffine les classes de lettres 'classes' (de 1 à *nb_classes - 1, 
+ * 0 pour les octets hors de l'alphabet) par les transitions d'un 
+ * automate : deux lettres d'une même classe n'y restent que si elles 
+ * mènent aux mêmes états depuis chaque état.
+ *
+ * État par état, seules les lettres qui ont des transitions sont 
+ * examinées : elles sont triées par classe et par états d'arrivée, et 
+ * une classe n'est coupée que si ses lettres ne mènent pas toutes au 
+ * même ensemble d'états.
+ */
+static void raffiner_classes( 
+	const Automate* automate, int classes[256], int* nb_classes 
+){
+	const Adjacence* adj = adjacence_automate( automate );
+	int taille[257];
+	Lettre_lue lues[256];
+	int i, j, o;
+
+	memset( taille, 0, sizeof(taille) );
+	for( o = 0; o < 256; o++ ){
+		if( classes[o] ) taille[ classes[o] ]++;
+	}
+
+	for( i = 0; i < adj->nb_etats; i++ ){
+		int nb_lues = 0;
+		j = adj->debut[i];
+		while( j < adj->debut[i+1] ){
+			char lettre = adj->lettres[j];
+			Lettre_lue* l = &lues[ nb_lues++ ];
+			l->classe = classes[ (unsigned char) lettre ];
+			l->debut = j;
+			l->hachage = 0xcbf29ce484222325ULL;
+			for( ; j < adj->debut[i+1] && adj->lettres[j] == lettre; j++ ){
+				l->hachage = ( l->hachage ^ (uint64_t) adj->voisins[j] ) * 0x100000001b3ULL;
+			}
+			l->fin = j;
+		}
+		qsort( lues, nb_lues, sizeof(Lettre_lue), comparer_lettres_lues );
+
+		int a = 0;
+		while( a < nb_lues ){
+			int c = lues[a].classe;
+			int b = a;
+			while( b < nb_lues && lues[b].classe == c ) b++;
+			// Les lettres lues[a..b[ sont celles de la classe c : chacune 
+			// reçoit la classe de la première lettre identique.
+			int nouvelles[256];
+			int x, y;
+			for( x = a; x < b; x++ ){
+				nouvelles[x] = -1;
+				for( y = a; y < x && nouvelles[x] < 0; y++ ){
+					if( 
+						lues[y].hachage == lues[x].hachage
+						&& lues[y].fin - lues[y].debut == lues[x].fin - lues[x].debut
+						&& memcmp( 
+							adj->voisins + lues[y].debut, adj->voisins + lues[x].debut,
+							( lues[x].fin - lues[x].debut ) * sizeof(int)
+						) == 0
+					){
+						nouvelles[x] = nouvelles[y];
+					}
+				}
+				if( nouvelles[x] < 0 ){
+					// La classe c est gardée par le premier groupe si 
+					// toutes ses lettres sont lues ici.
+					nouvelles[x] = ( x == a && b - a == taille[c] ) ? c : (*nb_classes)++;
+				}
+			}
+			for( x = a; x < b; x++ ){
+				if( nouvelles[x] != c ){
+					taille[c]--;
+					taille[ nouvelles[x] ]++;
+					classes[ (unsigned char) adj->lettres[ lues[x].debut ] ] = nouvelles[x];
+				}
+			}
+			a = b;
+		}
+	}
+}
+
+/*
+ * Renumérote les classes dans l'ordre de leur plus petite lettre, en 
+ * suivant l'ordre de l'alphabet, et remplit les tableaux de sortie. 
+ * raffiner_classes() ne crée un numéro qu'en ajoutant une classe non 
+ * vide : les numéros provisoires vont de 1 à 256 au plus, et il y a au 
+ * plus 257 classes, classe 0 comprise.
+ */
+static int numeroter_classes( 
+	const Ensemble* alphabet, const int classes[256],
+	uint16_t res_classes[256], char representants[257]
 ){
-	
-	Table_iterateur it = trouver_table( ensemble_to_id, (intptr_t) ens );
-	if( iterateur_est_vide( it ) ){
-		add_table( ensemble_to_id, (intptr_t) ens, next_id );
-		add_table( id_to_ensemble, next_id, (intptr_t) ens );
-		ajouter_fifo( f, (intptr_t) ens );
-		ajouter_etat( aut, next_id );
-		return next_id+1;
-	}else{
-		return next_id;
+	int numero[257];
+	int nb = 1, c;
+	for( c = 0; c < 257; c++ ) numero[c] = -1;
+	memset( res_classes, 0, 256 * sizeof(uint16_t) );
+	Ensemble_iterateur it;
+	for(
+		it = premier_iterateur_ensemble( alphabet );
+		! iterateur_ensemble_est_vide( it );
+		it = iterateur_suivant_ensemble( it )
+	){
+		char lettre = (char) get_element( it );
+		c = classes[ (unsigned char) lettre ];
+		if( numero[c] < 0 ){
+			numero[c] = nb;
+			if( representants ) representants[nb] = lettre;
+			nb++;
+		}
+		res_classes[ (unsigned char) lettre ] = numero[c];
+	}
+	return nb;
+}
+
+static void initialiser_classes( const Ensemble* alphabet, int classes[256] ){
+	memset( classes, 0, 256 * sizeof(int) );
+	Ensemble_iterateur it;
+	for(
+		it = premier_iterateur_ensemble( alphabet );
+		! iterateur_ensemble_est_vide( it );
+		it = iterateur_suivant_ensemble( it )
+	){
+		classes[ (unsigned char) get_element( it ) ] = 1;
 	}
 }
 
+int classes_de_lettres( 
+	const Automate* automate, uint16_t classes[256], char representants[257] 
+){
+	int provisoires[256];
+	int nb = 2;
+	initialiser_classes( get_alphabet( automate ), provisoires );
+	raffiner_classes( automate, provisoires, &nb );
+	return numeroter_classes( 
+		get_alphabet( automate ), provisoires, classes, representants 
+	);
+}
+
+int classes_de_lettres_communes( 
+	const Automate* automate_1, const Automate* automate_2, 
+	uint16_t classes[256], char representants[257] 
+){
+	int provisoires[256];
+	int nb = 2;
+	Ensemble* alphabet = creer_union_ensemble( 
+		get_alphabet( automate_1 ), get_alphabet( automate_2 ) 
+	);
+	initialiser_classes( alphabet, provisoires );
+	raffiner_classes( automate_1, provisoires, &nb );
+	raffiner_classes( automate_2, provisoires, &nb );
+	int res = numeroter_classes( alphabet, provisoires, classes, representants );
+	liberer_ensemble( alphabet );
+	return res;
+}
+
 Automate * creer_automate_deterministe( const Automate* automate ){
+	Dictionnaire* sous_ensembles;
+	Automate * res = 
+		creer_automate_deterministe_sous_ensembles( automate, &sous_ensembles );
+	liberer_dictionnaire( sous_ensembles );
+	return res;
+}
+
+Automate * creer_automate_deterministe_sous_ensembles( 
+	const Automate* automate, Dictionnaire** res_sous_ensembles 
+){
 	Automate * res = creer_automate();
 
-	Fifo* f = creer_fifo();
-	Table* ensemble_to_id = creer_table(
-		( int(*)(const intptr_t, const intptr_t) ) comparer_ensemble, 
-		( intptr_t (*)( const intptr_t ) ) copier_ensemble,
-		( void(*)(intptr_t) ) liberer_ensemble
-	);
-	Table* id_to_ensemble = creer_table( NULL, NULL, NULL );
+	// Les sous-ensembles d'états sont numérotés dans l'ordre de leur
+	// découverte : le dictionnaire sert donc aussi de file.
+	Dictionnaire* sous_ensembles = creer_dictionnaire();
 	
-	int next_id = ajouter_ensemble(
-		copier_ensemble( get_initiaux( automate ) ), 
-		ensemble_to_id, id_to_ensemble, f, res, 0
+	identifiant_ensemble(
+		sous_ensembles, copier_ensemble( get_initiaux( automate ) ), NULL
 	);
 	ajouter_etat_initial( res, 0 );
 
-	while( ! est_vide( f ) ){
-		Ensemble* e = (Ensemble*) retirer_fifo( f );
-		int id_e = get_valeur( trouver_table( ensemble_to_id, (intptr_t) e ) );
+	// Les lettres équivalentes mènent aux mêmes sous-ensembles : delta()
+	// n'est calculé que pour une lettre de chaque classe.
+	uint16_t classes[256];
+	char representants[257];
+	int nb_classes = classes_de_lettres( automate, classes, representants );
+	int cibles[257];
+
+	int id_e;
+	for( id_e = 0; id_e < taille_dictionnaire( sous_ensembles ); id_e++ ){
+		const Ensemble* e = ensemble_de_identifiant( sous_ensembles, id_e );
+
+		int c;
+		for( c = 1; c < nb_classes; c++ ){
+			int nouveau;
+			cibles[c] = identifiant_ensemble(
+				sous_ensembles, delta( automate, e, representants[c] ), &nouveau
+			);
+			if( nouveau ){
+				ajouter_etat( res, cibles[c] );
+			}
+		}
 
 		Ensemble_iterateur it_lettre;
 		for(
@@ -835,20 +1340,9 @@ Automate * creer_automate_deterministe( const Automate* automate ){
 			it_lettre = iterateur_suivant_ensemble( it_lettre )
 		){
 			char lettre = (char) get_element( it_lettre );
-			Ensemble * img = delta( automate, e, lettre );
-			int id = ajouter_ensemble(
-				img, ensemble_to_id, id_to_ensemble, f, res, next_id
-			);
-			ajouter_transition(
-				res, id_e, lettre, get_valeur(
-					trouver_table( ensemble_to_id, (intptr_t) img ) 
-				)
+			ajouter_transition( 
+				res, id_e, lettre, cibles[ classes[ (unsigned char) lettre ] ] 
 			);
-			if( next_id == id ){
-				liberer_ensemble(img);
-			}else{
-				next_id = id;
-			}
 		}
 
 		Ensemble_iterateur it_e;
@@ -866,24 +1360,293 @@ Automate * creer_automate_deterministe( const Automate* automate ){
 		
 	}
 
-	pour_toute_valeur_table(
-		id_to_ensemble,
-		( void (*)(intptr_t valeur ) ) liberer_ensemble
-	);
-	liberer_table( id_to_ensemble );
-	liberer_table( ensemble_to_id );
-	 
-	liberer_fifo( f );
+	*res_sous_ensembles = sous_ensembles;
 	return res;
 }
 
-Automate * creer_automate_minimal( const Automate* automate ){
-  // miror -> deter -> miror -> deter
-  Automate *res=miroir(automate);
-  res=creer_automate_deterministe(res);
-  res=miroir(res);
-  res=creer_automate_deterministe(res);
-  return res;
+int est_deterministe( const Automate* automate ){
+	if( taille_ensemble( get_initiaux( automate ) ) != 1 ){
+		return 0;
+	}
+	Table_iterateur it;
+	for(
+		it = premier_iterateur_table( automate->transitions );
+		! iterateur_est_vide( it );
+		it = iterateur_suivant_table( it )
+	){
+		if( taille_ensemble( (Ensemble*) get_valeur( it ) ) > 1 ){
+			return 0;
+		}
+	}
+	return 1;
+}
+
+Automate * creer_automate_minimal_brzozowski( const Automate* automate ){
+	// miroir -> deter -> miroir -> deter
+	Automate *mir = miroir( automate );
+	Automate *det = creer_automate_deterministe( mir );
+	liberer_automate( mir );
+	mir = miroir( det );
+	liberer_automate( det );
+	Automate *res = creer_automate_deterministe( mir );
+	liberer_automate( mir );
+	return res;
 }
 
+/*
+ * Partition des états utilisée par l'algorithme de Hopcroft.
+ *
+ * Les états d'un même bloc b sont rangés consécutivement dans 'elements',
+ * entre les indices debut[b] (inclus) et fin[b] (exclu). Les 'marques[b]'
+ * premiers états du bloc sont les états marqués.
+ */
+typedef struct {
+	int* elements;
+	int* position;
+	int* bloc;
+	int* debut;
+	int* fin;
+	int* marques;
+	int nb_blocs;
+} Partition;
+
+static void marquer_etat( Partition* p, int etat, int* touches, int* nb_touches ){
+	int b = p->bloc[etat];
+	int i = p->position[etat];
+	int j = p->debut[b] + p->marques[b];
+	if( i < j ) return;
+	if( p->marques[b] == 0 ){
+		touches[ (*nb_touches)++ ] = b;
+	}
+	int autre = p->elements[j];
+	p->elements[j] = etat;
+	p->elements[i] = autre;
+	p->position[etat] = j;
+	p->position[autre] = i;
+	p->marques[b]++;
+}
+
+/*
+ * Coupe le bloc b en sa partie marquée et sa partie non marquée.
+ * La plus petite des deux parties devient un nouveau bloc, dont le numéro
+ * est renvoyé. Renvoie -1 si le bloc n'a pas été coupé.
+ */
+static int couper_bloc( Partition* p, int b ){
+	int m = p->marques[b];
+	int taille = p->fin[b] - p->debut[b];
+	p->marques[b] = 0;
+	if( m == taille ) return -1;
+	int nouveau = p->nb_blocs++;
+	p->marques[nouveau] = 0;
+	if( 2*m <= taille ){
+		p->debut[nouveau] = p->debut[b];
+		p->fin[nouveau] = p->debut[b] + m;
+		p->debut[b] += m;
+	}else{
+		p->debut[nouveau] = p->debut[b] + m;
+		p->fin[nouveau] = p->fin[b];
+		p->fin[b] = p->debut[b] + m;
+	}
+	int i;
+	for( i = p->debut[nouveau]; i < p->fin[nouveau]; i++ ){
+		p->bloc[ p->elements[i] ] = nouveau;
+	}
+	return nouveau;
+}
+
+Automate * creer_automate_minimal_hopcroft( const Automate* automate ){
+	if( ! est_deterministe( automate ) ){
+		Automate* det = creer_automate_deterministe( automate );
+		Automate* res = creer_automate_minimal_hopcroft( det );
+		liberer_automate( det );
+		return res;
+	}
+
+	// Les états sont indicés par leur numéro dans l'index des transitions.
+	const Adjacence* adjacence = adjacence_automate( automate );
+	const int* etats = adjacence->etats;
+	int n = adjacence->nb_etats;
+	// Les lettres d'une même classe ne séparent jamais deux états : 
+	// l'algorithme travaille sur les k classes de lettres.
+	uint16_t classes[256];
+	int k = classes_de_lettres( automate, classes, NULL ) - 1;
+	// L'état d'indice n est un état puits, qui rend l'automate complet.
+	int nb = n+1;
+	int puits = n;
+	int i, j, c;
+	Ensemble_iterateur it;
 
+	// Table de transitions à plat : delta[q*k+c].
+	int* delta = xmalloc( (size_t) nb * k * sizeof(int) + 1 );
+	for( i = 0; i < nb*k; i++ ) delta[i] = puits;
+	for( i = 0; i < n; i++ ){
+		for( j = adjacence->debut[i]; j < adjacence->debut[i+1]; j++ ){
+			delta[ i*k + classes[ (unsigned char) adjacence->lettres[j] ] - 1 ] =
+				adjacence->voisins[j];
+		}
+	}
+
+	// Transitions inverses, lettre par lettre, au format CSR :
+	// les prédécesseurs de q par la lettre c sont 
+	// inverse[ inverse_debut[c*nb+q] .. inverse_debut[c*nb+q+1] [.
+	int* inverse_debut = xmalloc( ( (size_t) nb * k + 1 ) * sizeof(int) );
+	int* inverse = xmalloc( (size_t) nb * k * sizeof(int) + 1 );
+	memset( inverse_debut, 0, ( (size_t) nb * k + 1 ) * sizeof(int) );
+	for( i = 0; i < nb; i++ ){
+		for( c = 0; c < k; c++ ){
+			inverse_debut[ c*nb + delta[i*k+c] + 1 ]++;
+		}
+	}
+	for( i = 0; i < nb*k; i++ ){
+		inverse_debut[i+1] += inverse_debut[i];
+	}
+	int* remplissage = xmalloc( (size_t) nb * k * sizeof(int) + 1 );
+	memcpy( remplissage, inverse_debut, (size_t) nb * k * sizeof(int) );
+	for( i = 0; i < nb; i++ ){
+		for( c = 0; c < k; c++ ){
+			inverse[ remplissage[ c*nb + delta[i*k+c] ]++ ] = i;
+		}
+	}
+	xfree( remplissage );
+
+	// Partition initiale : états non finaux, puis états finaux.
+	Partition p;
+	p.elements = xmalloc( nb * sizeof(int) );
+	p.position = xmalloc( nb * sizeof(int) );
+	p.bloc = xmalloc( nb * sizeof(int) );
+	p.debut = xmalloc( nb * sizeof(int) );
+	p.fin = xmalloc( nb * sizeof(int) );
+	p.marques = xmalloc( nb * sizeof(int) );
+	p.nb_blocs = 0;
+	int nb_finaux = 0;
+	for( i = 0; i < n; i++ ){
+		if( est_un_etat_final_de_l_automate( automate, etats[i] ) ) nb_finaux++;
+	}
+	int prochain_non_final = 0, prochain_final = nb - nb_finaux;
+	for( i = 0; i < nb; i++ ){
+		int final = i < n && est_un_etat_final_de_l_automate( automate, etats[i] );
+		int pos = final ? prochain_final++ : prochain_non_final++;
+		p.elements[pos] = i;
+		p.position[i] = pos;
+	}
+	p.debut[0] = 0;
+	p.fin[0] = nb - nb_finaux;
+	p.marques[0] = 0;
+	p.nb_blocs = 1;
+	if( nb_finaux ){
+		p.debut[1] = nb - nb_finaux;
+		p.fin[1] = nb;
+		p.marques[1] = 0;
+		p.nb_blocs = 2;
+	}
+	for( i = 0; i < nb; i++ ){
+		p.bloc[ p.elements[i] ] = ( p.position[ p.elements[i] ] < nb - nb_finaux ) ? 0 : 1;
+	}
+
+	// Ensemble des séparateurs (bloc, lettre) à traiter.
+	int* attente_bloc = xmalloc( (size_t) nb * k * sizeof(int) + 1 );
+	int* attente_lettre = xmalloc( (size_t) nb * k * sizeof(int) + 1 );
+	int nb_attente = 0;
+	if( p.nb_blocs == 2 ){
+		int plus_petit = ( nb_finaux <= nb - nb_finaux ) ? 1 : 0;
+		for( c = 0; c < k; c++ ){
+			attente_bloc[nb_attente] = plus_petit;
+			attente_lettre[nb_attente++] = c;
+		}
+	}
+
+	int* predecesseurs = xmalloc( nb * sizeof(int) );
+	int* touches = xmalloc( nb * sizeof(int) );
+	while( nb_attente ){
+		nb_attente--;
+		int b = attente_bloc[nb_attente];
+		c = attente_lettre[nb_attente];
+
+		// L'automate étant complet et déterministe, les prédécesseurs par c
+		// d'états distincts sont distincts.
+		int nb_pred = 0;
+		for( i = p.debut[b]; i < p.fin[b]; i++ ){
+			int q = p.elements[i];
+			for( j = inverse_debut[c*nb+q]; j < inverse_debut[c*nb+q+1]; j++ ){
+				predecesseurs[nb_pred++] = inverse[j];
+			}
+		}
+		int nb_touches = 0;
+		for( i = 0; i < nb_pred; i++ ){
+			marquer_etat( &p, predecesseurs[i], touches, &nb_touches );
+		}
+		for( i = 0; i < nb_touches; i++ ){
+			int t = touches[i];
+			int nouveau = couper_bloc( &p, t );
+			if( nouveau < 0 ) continue;
+			// Le nouveau bloc est toujours la plus petite des deux parties :
+			// il suffit de l'ajouter pour chaque lettre.
+			int d;
+			for( d = 0; d < k; d++ ){
+				attente_bloc[nb_attente] = nouveau;
+				attente_lettre[nb_attente++] = d;
+			}
+		}
+	}
+
+	// On numérote les blocs accessibles dans l'ordre d'un parcours en 
+	// largeur depuis l'état initial, en suivant l'ordre de l'alphabet.
+	Automate * res = creer_automate();
+	int* numero = xmalloc( p.nb_blocs * sizeof(int) );
+	int* file = xmalloc( p.nb_blocs * sizeof(int) );
+	for( i = 0; i < p.nb_blocs; i++ ) numero[i] = -1;
+	int initial = numero_etat( 
+		adjacence, get_element( premier_iterateur_ensemble( get_initiaux( automate ) ) )
+	);
+	int nb_file = 0, tete = 0;
+	file[nb_file++] = p.bloc[initial];
+	numero[ p.bloc[initial] ] = 0;
+	ajouter_etat_initial( res, 0 );
+	for(
+		it = premier_iterateur_ensemble( get_alphabet( automate ) );
+		! iterateur_ensemble_est_vide( it );
+		it = iterateur_suivant_ensemble( it )
+	){
+		ajouter_lettre( res, (char) get_element( it ) );
+	}
+	while( tete < nb_file ){
+		int b = file[tete++];
+		int representant = p.elements[ p.debut[b] ];
+		if(
+			representant < n &&
+			est_un_etat_final_de_l_automate( automate, etats[representant] )
+		){
+			ajouter_etat_final( res, numero[b] );
+		}
+		for(
+			it = premier_iterateur_ensemble( get_alphabet( automate ) );
+			! iterateur_ensemble_est_vide( it );
+			it = iterateur_suivant_ensemble( it )
+		){
+			char lettre = (char) get_element( it );
+			c = classes[ (unsigned char) lettre ] - 1;
+			int cible = p.bloc[ delta[ representant*k + c ] ];
+			if( numero[cible] < 0 ){
+				numero[cible] = nb_file;
+				file[nb_file++] = cible;
+			}
+			ajouter_transition( res, numero[b], lettre, numero[cible] );
+		}
+	}
+
+	xfree( numero ); xfree( file );
+	xfree( predecesseurs ); xfree( touches );
+	xfree( attente_bloc ); xfree( attente_lettre );
+	xfree( p.elements ); xfree( p.position ); xfree( p.bloc );
+	xfree( p.debut ); xfree( p.fin ); xfree( p.marques );
+	xfree( inverse ); xfree( inverse_debut );
+	xfree( delta );
+	return res;
+}
+
+Automate * creer_automate_minimal( const Automate* automate ){
+	if( est_deterministe( automate ) ){
+		return creer_automate_minimal_hopcroft( automate );
+	}
+	return creer_automate_minimal_brzozowski( automate );
+}
@@ -24,6 +24,9 @@
 #define __AUTOMATE_H__
 
 #include "ensemble.h"
+#include "dictionnaire.h"
+
+#include <stdint.h>
 
 /**
  * @brief Le type d'un automate.
@@ -34,7 +37,42 @@
  * pas d'epsilon transition.
  * L'automate codé peut avoir plusieurs états initiaux.
  * 
+ * Les fonctions qui prennent un automate constant peuvent être appelées 
+ * par plusieurs fils d'exécution en même temps sur le même automate, tant 
+ * qu'aucun fil ne le modifie ni ne le libère : elles ne font que le lire, 
+ * à part les index d'adjacence et la simulation bit à bit, construits à 
+ * la demande et publiés de façon atomique. Toute modification de l'automate doit en revanche être 
+ * faite par un seul fil, sans lecture concurrente.
+ */
+
+struct Automate_bits;
+
+/**
+ * @brief Index des transitions d'un automate, au format CSR.
+ *
+ * Les états sont numérotés de 0 à nb_etats-1 dans l'ordre croissant : 
+ * etats[i] est l'état de numéro i (voir numero_etat()). Les transitions
+ * de l'état de numéro i sont celles d'indices debut[i] à debut[i+1]-1 : 
+ * la j-ième lit la lettre lettres[j] et mène à l'état de numéro 
+ * voisins[j]. 
+ *
+ * Dans l'index direct (voir adjacence_automate()), les transitions d'un 
+ * état sont celles qui en partent, triées par lettre puis par état 
+ * d'arrivée. Dans l'index inverse (voir adjacence_inverse_automate()), 
+ * ce sont celles qui y arrivent, triées par état de départ puis par 
+ * lettre : voisins[j] est alors l'état de départ.
  */
+typedef struct Adjacence {
+	int nb_etats;
+	int nb_transitions;
+	int* etats;
+	/** Si non NULL, numeros[ q - etats[0] ] est le numéro de l'état q. */
+	int* numeros;
+	int nb_numeros;
+	int* debut;
+	char* lettres;
+	int* voisins;
+} Adjacence;
 
 struct Automate {
    Ensemble * vide; //!<
@@ -43,6 +81,22 @@ struct Automate {
 	Table* transitions;
 	Ensemble * initiaux;
 	Ensemble * finaux;
+	/** 
+	 * Simulation bit à bit de l'automate (voir automate_bits.h), ou NULL.
+	 * Si 'simulable' vaut 1, elle est construite à la première lecture 
+	 * d'un mot (voir simulation_automate()). Toute modification de 
+	 * l'automate la détruit et remet 'simulable' à 0.
+	 */
+	struct Automate_bits * _Atomic simulation;
+	_Atomic int simulable;
+	/** 
+	 * Index des transitions sortantes et entrantes, ou NULL s'ils n'ont pas 
+	 * encore été demandés. Ils sont détruits dès que l'automate est modifié.
+	 * Ils sont publiés de façon atomique, car plusieurs fils d'exécution 
+	 * peuvent les demander en même temps (voir adjacence_automate()).
+	 */
+	Adjacence * _Atomic adjacence;
+	Adjacence * _Atomic adjacence_inverse;
 };
 
 typedef struct Automate Automate;
@@ -217,6 +271,20 @@ int est_un_etat_final_de_l_automate( const Automate* automate, int etat );
  */ 
 int est_une_lettre_de_l_automate( const Automate* automate, char lettre );
 
+/**
+ * @brief Renvoie l'ensemble des états atteints depuis un état en lisant une
+ *        lettre.
+ *
+ * La mémoire de l'ensemble renvoyé est gérée par l'automate.
+ * L'utilisateur ne doit donc pas modifier ou libérer l'ensemble ainsi obtenu.
+ *
+ * @param automate Un automate.
+ * @param origine L'état de départ.
+ * @param lettre Une lettre.
+ * @return L'ensemble des fins des transitions (origine, lettre, fin).
+ */ 
+const Ensemble * voisins( const Automate* automate, int origine, char lettre );
+
 /**
  * @brief Renvoie l'ensemble des états accéssibles à partir d'un ensemble 
  *        d'états donné en paramètre et en lisant une lettre donnée en 
@@ -320,10 +388,108 @@ int get_min_etat( const Automate* automate );
  */ 
 Automate* copier_automate( const Automate* automate );
 
+/**
+ * @brief Renvoie la simulation bit à bit d'un automate, ou NULL s'il n'en 
+ *        a pas.
+ *
+ * Seuls les automates dont le champ 'simulable' vaut 1, comme ceux 
+ * construits par Glushkov(), ont une simulation. Elle est construite à la
+ * première demande, par delta_star() ou le_mot_est_reconnu(), et publiée 
+ * comme les index (voir adjacence_automate()) ; delta() ne s'en sert que 
+ * si elle existe déjà. Si l'automate ne 
+ * peut pas être simulé bit à bit, 'simulable' est remis à 0.
+ *
+ * @param automate Un automate.
+ * @return La simulation, ou NULL.
+ */
+const struct Automate_bits* simulation_automate( const Automate* automate );
+
+/**
+ * @brief Renvoie l'index des transitions sortantes d'un automate.
+ *
+ * L'index est construit à la première demande, en un parcours de la table
+ * des transitions, puis gardé par l'automate jusqu'à sa prochaine 
+ * modification : il ne doit être ni libéré, ni utilisé après une 
+ * modification de l'automate.
+ *
+ * Plusieurs fils d'exécution peuvent l'appeler en même temps sur le même 
+ * automate : s'ils construisent chacun un index, un seul est gardé et 
+ * tous le reçoivent.
+ *
+ * @param automate Un automate.
+ * @return L'index.
+ */
+const Adjacence* adjacence_automate( const Automate* automate );
+
+/**
+ * @brief Renvoie l'index des transitions entrantes d'un automate.
+ *
+ * Voir adjacence_automate().
+ *
+ * @param automate Un automate.
+ * @return L'index.
+ */
+const Adjacence* adjacence_inverse_automate( const Automate* automate );
+
+/**
+ * @brief Renvoie le numéro d'un état dans un index, ou -1 si ce n'est pas 
+ *        un état de l'automate.
+ *
+ * @param adjacence Un index.
+ * @param etat Un état.
+ * @return Le numéro de l'état.
+ */
+int numero_etat( const Adjacence* adjacence, int etat );
+
+/**
+ * @brief Calcule les classes d'équivalence des lettres d'un automate.
+ *
+ * Deux lettres sont équivalentes si, depuis chaque état, elles mènent aux
+ * mêmes états : les algorithmes n'ont alors besoin de lire qu'une lettre
+ * par classe. 
+ *
+ * En sortie, classes[o] est la classe de l'octet o : 0 s'il n'est pas 
+ * dans l'alphabet, et sinon un entier entre 1 et le nombre de classes 
+ * moins 1. Il y a jusqu'à 256 classes de lettres, plus la classe 0 : 
+ * les classes ne tiennent donc pas toujours dans un octet. Les classes 
+ * sont numérotées dans l'ordre de leur plus petite lettre, qui est rangée
+ * dans representants[c] si 'representants' est non NULL.
+ *
+ * @param automate Un automate.
+ * @param classes Reçoit la classe de chaque octet.
+ * @param representants Reçoit la plus petite lettre de chaque classe, ou 
+ *        NULL.
+ * @return Le nombre de classes, classe 0 comprise.
+ */
+int classes_de_lettres( 
+	const Automate* automate, uint16_t classes[256], char representants[257] 
+);
+
+/**
+ * @brief Calcule les classes des lettres équivalentes à la fois dans deux
+ *        automates, sur l'union de leurs alphabets.
+ *
+ * Voir classes_de_lettres().
+ *
+ * @param automate_1 Le premier automate.
+ * @param automate_2 Le second automate.
+ * @param classes Reçoit la classe de chaque octet.
+ * @param representants Reçoit la plus petite lettre de chaque classe, ou 
+ *        NULL.
+ * @return Le nombre de classes, classe 0 comprise.
+ */
+int classes_de_lettres_communes( 
+	const Automate* automate_1, const Automate* automate_2, 
+	uint16_t classes[256], char representants[257] 
+);
+
 /**
  * @brief Renvoie l'ensemble des états accessibles à partir d'un état en lisant 
  *        un mot quelcquonque.
  *
+ * Les fonctions d'accessibilité font un seul parcours de l'automate, qui
+ * examine chaque transition une fois.
+ *
  * @param automate Un automate.
  * @param etat L'état de départ.
  * @return L'ensemble des états accessibles.
@@ -339,6 +505,15 @@ Ensemble* etats_accessibles( const Automate * automate, int etat );
  */ 
 Ensemble* accessibles( const Automate * automate );
 
+/**
+ * @brief Renvoie l'ensemble des états depuis lesquels un état final est 
+ *        accessible.
+ *
+ * @param automate Un automate.
+ * @return L'ensemble des états co-accessibles.
+ */ 
+Ensemble* coaccessibles( const Automate * automate );
+
 /**
  * @brief Renvoie l'automate passé en paramètre dont les états non accessibles 
  *        ont été supprimés.
@@ -348,6 +523,18 @@ Ensemble* accessibles( const Automate * automate );
  */ 
 Automate *automate_accessible( const Automate * automate );
 
+/**
+ * @brief Renvoie l'automate émondé : l'automate passé en paramètre dont 
+ *        les états qui ne sont pas à la fois accessibles et co-accessibles
+ *        ont été supprimés.
+ *
+ * Il reconnaît le même langage. L'alphabet est conservé.
+ *
+ * @param automate Un automate.
+ * @return L'automate émondé.
+ */ 
+Automate *automate_emonde( const Automate * automate );
+
 /**
  * @brief @todo Renvoie l'automate miroir d'un automate.
  *
@@ -370,6 +557,13 @@ void print_automate( const Automate * automate );
 /**
  * @brief Crée l'intersection de deux automates.
  *
+ * Seuls les couples d'états accessibles depuis les couples d'états 
+ * initiaux sont construits, par un parcours en largeur. Ils sont 
+ * numérotés à partir de 0, dans l'ordre de ce parcours.
+ *
+ * @param automate_1 Le premier automate.
+ * @param automate_2 Le second automate.
+ * @return L'automate produit, qui reconnaît l'intersection des langages.
  */
 Automate * creer_intersection_des_automates(
 	const Automate * automate_1, const Automate * automate_2
@@ -384,13 +578,70 @@ Automate * creer_intersection_des_automates(
 Automate * creer_automate_deterministe( const Automate* automate );
 
 /**
- * @brief @todo Renvoie l'automate minimal.
+ * @brief Renvoie l'automate déterministe, ainsi que les sous-ensembles
+ *        d'états qui forment ses états.
+ *
+ * L'état i de l'automate renvoyé est le sous-ensemble d'états de 
+ * l'automate de départ d'identifiant i dans le dictionnaire. L'état 
+ * initial est 0.
+ *
+ * @param automate L'automate à déterminiser.
+ * @param sous_ensembles Reçoit le dictionnaire des sous-ensembles, à 
+ *        libérer avec liberer_dictionnaire().
+ * @return L'automate déterministe correspondant.
+ */ 
+Automate * creer_automate_deterministe_sous_ensembles( 
+	const Automate* automate, Dictionnaire** sous_ensembles 
+);
+
+/**
+ * @brief Renvoie 1 si l'automate est déterministe et 0 sinon.
+ *
+ * Un automate est déterministe s'il a exactement un état initial et au plus 
+ * une transition par état et par lettre. Il n'est pas nécessairement 
+ * complet.
+ *
+ * @param automate Un automate.
+ * @return 1 ou 0.
+ */
+int est_deterministe( const Automate* automate );
+
+/**
+ * @brief Renvoie l'automate minimal.
+ *
+ * Si l'automate est déterministe, l'algorithme de Hopcroft est utilisé
+ * (voir creer_automate_minimal_hopcroft()), sinon l'algorithme de 
+ * Brzozowski (voir creer_automate_minimal_brzozowski()).
  *
  * @param automate L'automate à minimiser.
  * @return L'automate minimal correspondant.
  */ 
 Automate * creer_automate_minimal( const Automate* automate );
 
+/**
+ * @brief Renvoie l'automate minimal, calculé par l'algorithme de Brzozowski
+ *        (miroir, déterminisation, miroir, déterminisation).
+ *
+ * @param automate L'automate à minimiser.
+ * @return L'automate minimal correspondant.
+ */ 
+Automate * creer_automate_minimal_brzozowski( const Automate* automate );
+
+/**
+ * @brief Renvoie l'automate minimal, calculé par l'algorithme de raffinement
+ *        de partition de Hopcroft, en O(n.k.log(n)) pour n états et k 
+ *        lettres.
+ *
+ * Si l'automate n'est pas déterministe, il est d'abord déterminisé.
+ * L'automate renvoyé est complet, ses états sont numérotés à partir de 0 
+ * (l'état initial) dans l'ordre d'un parcours en largeur qui suit l'ordre 
+ * de l'alphabet.
+ *
+ * @param automate L'automate à minimiser.
+ * @return L'automate minimal correspondant.
+ */ 
+Automate * creer_automate_minimal_hopcroft( const Automate* automate );
+
 /**
  * @brief Renvoie le nombre de transitions d'un automate.
  *
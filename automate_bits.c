@@ -0,0 +1,273 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "automate_bits.h"
+#include "outils.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_MOTS ( AUTOMATE_BITS_MAX_ETATS / 64 )
+
+static void ajouter_bit( uint64_t* bits, int i ){
+	bits[ i / 64 ] |= (uint64_t) 1 << ( i % 64 );
+}
+
+static int comparer_int( const void* a, const void* b ){
+	int x = *(const int*) a;
+	int y = *(const int*) b;
+	return ( x > y ) - ( x < y );
+}
+
+/*
+ * Renvoie l'indice d'un état, ou -1 s'il n'est pas dans la simulation.
+ */
+static int indice_etat( const Automate_bits* automate, int etat ){
+	const int* trouve = bsearch( 
+		&etat, automate->etats, automate->nb_etats, sizeof(int), comparer_int
+	);
+	return trouve ? trouve - automate->etats : -1;
+}
+
+typedef struct {
+	Automate_bits* res;
+	// Lettre portée par les transitions qui arrivent dans chaque état 
+	// (-1 : pas encore de transition).
+	int* lettre_entrante;
+	int homogene;
+} data_creer_automate_bits;
+
+static void action_creer_automate_bits( 
+	int origine, char lettre, int fin, void* data 
+){
+	data_creer_automate_bits* d = (data_creer_automate_bits*) data;
+	Automate_bits* res = d->res;
+	int o = indice_etat( res, origine );
+	int f = indice_etat( res, fin );
+	int l = (unsigned char) lettre;
+	if( d->lettre_entrante[f] >= 0 && d->lettre_entrante[f] != l ){
+		d->homogene = 0;
+	}
+	d->lettre_entrante[f] = l;
+	ajouter_bit( res->suivants + (size_t) o * res->nb_mots, f );
+	ajouter_bit( res->lettres + (size_t) l * res->nb_mots, f );
+}
+
+/*
+ * Remplit les tables de suivants : la valeur v d'un bloc est celle de 
+ * v & (v-1), à laquelle on ajoute les suivants de l'état de son bit de 
+ * poids faible. Chaque entrée coûte donc une union de nb_mots mots.
+ */
+static void creer_tables( Automate_bits* res ){
+	int nb_mots = res->nb_mots;
+	size_t taille_entree = nb_mots * sizeof(uint64_t);
+	res->largeur = 8;
+	while( 
+		res->largeur > 2 
+		&& (size_t) ( ( res->nb_etats + res->largeur - 1 ) / res->largeur ) 
+			* ( 1 << res->largeur ) * taille_entree > AUTOMATE_BITS_TAILLE_TABLES
+	){
+		res->largeur /= 2;
+	}
+	res->nb_blocs = ( res->nb_etats + res->largeur - 1 ) / res->largeur;
+	int nb_valeurs = 1 << res->largeur;
+	res->tables = xmalloc( 
+		(size_t) res->nb_blocs * nb_valeurs * taille_entree + 1
+	);
+	int b, v, j;
+	for( b = 0; b < res->nb_blocs; b++ ){
+		uint64_t* table = res->tables + (size_t) b * nb_valeurs * nb_mots;
+		memset( table, 0, taille_entree );
+		for( v = 1; v < nb_valeurs; v++ ){
+			int q = b * res->largeur + __builtin_ctz( v );
+			uint64_t* entree = table + (size_t) v * nb_mots;
+			const uint64_t* reste = table + (size_t) ( v & ( v - 1 ) ) * nb_mots;
+			if( q >= res->nb_etats ){
+				memcpy( entree, reste, taille_entree );
+				continue;
+			}
+			const uint64_t* s = res->suivants + (size_t) q * nb_mots;
+			for( j = 0; j < nb_mots; j++ ) entree[j] = reste[j] | s[j];
+		}
+	}
+}
+
+Automate_bits* creer_automate_bits( const Automate* automate ){
+	int n = taille_ensemble( get_etats( automate ) );
+	if( n > AUTOMATE_BITS_MAX_ETATS ){
+		return NULL;
+	}
+	Automate_bits* res = xmalloc( sizeof(Automate_bits) );
+	res->nb_etats = n;
+	res->nb_mots = ( n + 63 ) / 64;
+	if( res->nb_mots == 0 ) res->nb_mots = 1;
+	size_t taille_mots = res->nb_mots * sizeof(uint64_t);
+	res->etats = xmalloc( ( n + 1 ) * sizeof(int) );
+	res->suivants = xmalloc( ( n + 1 ) * taille_mots );
+	res->lettres = xmalloc( 256 * taille_mots );
+	res->initiaux = xmalloc( taille_mots );
+	res->finaux = xmalloc( taille_mots );
+	memset( res->suivants, 0, ( n + 1 ) * taille_mots );
+	memset( res->lettres, 0, 256 * taille_mots );
+
+	int i = 0;
+	Ensemble_iterateur it;
+	for(
+		it = premier_iterateur_ensemble( get_etats( automate ) );
+		! iterateur_ensemble_est_vide( it );
+		it = iterateur_suivant_ensemble( it )
+	){
+		res->etats[i++] = get_element( it );
+	}
+	ensemble_vers_bits( res, get_initiaux( automate ), res->initiaux );
+	ensemble_vers_bits( res, get_finaux( automate ), res->finaux );
+
+	data_creer_automate_bits data;
+	data.res = res;
+	data.homogene = 1;
+	data.lettre_entrante = xmalloc( ( n + 1 ) * sizeof(int) );
+	for( i = 0; i < n; i++ ) data.lettre_entrante[i] = -1;
+	pour_toute_transition( automate, action_creer_automate_bits, &data );
+	xfree( data.lettre_entrante );
+
+	if( ! data.homogene ){
+		res->tables = NULL;
+		liberer_automate_bits( res );
+		return NULL;
+	}
+	creer_tables( res );
+	return res;
+}
+
+void liberer_automate_bits( Automate_bits* automate ){
+	if( automate ){
+		xfree( automate->etats );
+		xfree( automate->suivants );
+		xfree( automate->lettres );
+		xfree( automate->initiaux );
+		xfree( automate->finaux );
+		xfree( automate->tables );
+		xfree( automate );
+	}
+}
+
+void delta_star_bits(
+	const Automate_bits* automate, uint64_t* etats, 
+	const char* mot, size_t longueur
+){
+	int nb_mots = automate->nb_mots;
+	const unsigned char* octets = (const unsigned char*) mot;
+	int largeur = automate->largeur;
+	size_t nb_blocs = automate->nb_blocs;
+	int log_largeur = __builtin_ctz( largeur );
+	int blocs_par_mot = 64 / largeur;
+	uint64_t masque = ( (uint64_t) 1 << largeur ) - 1;
+	uint64_t suivants[MAX_MOTS];
+	size_t i;
+	int k;
+	for( i = 0; i < longueur; i++ ){
+		memset( suivants, 0, nb_mots * sizeof(uint64_t) );
+		// Union des suivants des états courants, mot par mot. Un mot qui a
+		// au moins autant d'états que de blocs lit l'entrée de table de 
+		// chacun de ses blocs, nuls compris, sans branchement. Dans un mot creux, seuls les blocs non nuls sont 
+		// lus, trouvés par leur premier bit : un bloc d'un seul état lit la
+		// ligne de cet état dans 'suivants', plus petite que les tables. 
+		// Une transition coûte donc au plus une union par état courant.
+		for( k = 0; k < nb_mots; k++ ){
+			uint64_t m = etats[k];
+			if( ! m ) continue;
+			size_t b = (size_t) k * blocs_par_mot;
+			size_t fin = b + blocs_par_mot < nb_blocs ? b + blocs_par_mot : nb_blocs;
+			int j;
+			if( __builtin_popcountll( m ) >= fin - b ){
+				for( ; b < fin; b++, m >>= largeur ){
+					const uint64_t* s = automate->tables + 
+						( ( b << largeur ) + ( m & masque ) ) * nb_mots;
+					for( j = 0; j < nb_mots; j++ ) suivants[j] |= s[j];
+				}
+				continue;
+			}
+			while( m ){
+				int bit = __builtin_ctzll( m );
+				int decalage = bit & ~( largeur - 1 );
+				uint64_t v = ( m >> decalage ) & masque;
+				m &= ~( masque << decalage );
+				const uint64_t* s;
+				if( v & ( v - 1 ) ){
+					s = automate->tables + 
+						( ( ( b + ( decalage >> log_largeur ) ) << largeur ) + v ) * nb_mots;
+				}else{
+					s = automate->suivants + ( (size_t) 64 * k + bit ) * nb_mots;
+				}
+				for( j = 0; j < nb_mots; j++ ) suivants[j] |= s[j];
+			}
+		}
+		const uint64_t* lettre = automate->lettres + (size_t) octets[i] * nb_mots;
+		uint64_t non_vide = 0;
+		for( k = 0; k < nb_mots; k++ ){
+			etats[k] = suivants[k] & lettre[k];
+			non_vide |= etats[k];
+		}
+		if( ! non_vide ) return;
+	}
+}
+
+int le_mot_est_reconnu_bits(
+	const Automate_bits* automate, const char* mot, size_t longueur
+){
+	uint64_t etats[MAX_MOTS];
+	int k;
+	memcpy( etats, automate->initiaux, automate->nb_mots * sizeof(uint64_t) );
+	delta_star_bits( automate, etats, mot, longueur );
+	for( k = 0; k < automate->nb_mots; k++ ){
+		if( etats[k] & automate->finaux[k] ) return 1;
+	}
+	return 0;
+}
+
+void ensemble_vers_bits(
+	const Automate_bits* automate, const Ensemble* ensemble, uint64_t* etats
+){
+	memset( etats, 0, automate->nb_mots * sizeof(uint64_t) );
+	Ensemble_iterateur it;
+	for(
+		it = premier_iterateur_ensemble( ensemble );
+		! iterateur_ensemble_est_vide( it );
+		it = iterateur_suivant_ensemble( it )
+	){
+		int i = indice_etat( automate, get_element( it ) );
+		if( i >= 0 ) ajouter_bit( etats, i );
+	}
+}
+
+Ensemble* bits_vers_ensemble( const Automate_bits* automate, const uint64_t* etats ){
+	Ensemble* res = creer_ensemble( NULL, NULL, NULL );
+	int k;
+	for( k = 0; k < automate->nb_mots; k++ ){
+		uint64_t m = etats[k];
+		while( m ){
+			ajouter_element( 
+				res, automate->etats[ 64 * k + __builtin_ctzll( m ) ] 
+			);
+			m &= m - 1;
+		}
+	}
+	return res;
+}
@@ -0,0 +1,151 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file automate_bits.h */ 
+
+#ifndef __AUTOMATE_BITS_H__
+#define __AUTOMATE_BITS_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "automate.h"
+
+/**
+ * @brief Nombre maximal d'états d'un automate simulé bit à bit.
+ */
+#define AUTOMATE_BITS_MAX_ETATS 4096
+
+/**
+ * @brief Taille maximale, en octets, des tables de suivants d'une 
+ *        simulation bit à bit.
+ */
+#define AUTOMATE_BITS_TAILLE_TABLES ( 1 << 22 )
+
+/**
+ * @brief Le type de la simulation bit à bit d'un automate homogène.
+ *
+ * Un automate est homogène si toutes les transitions qui arrivent dans un 
+ * même état portent la même lettre. C'est le cas des automates de 
+ * Glushkov, où l'état i est la position i de l'expression.
+ *
+ * Un ensemble d'états est alors codé par un vecteur de 'nb_mots' mots de 
+ * 64 bits : le bit i correspond à l'état etats[i]. Pour un ensemble 
+ * d'états D, l'ensemble atteint en lisant l'octet c est
+ *     ( union des suivants[q] pour q dans D ) & lettres[c],
+ * où suivants[q] est l'ensemble des fins des transitions issues de q et 
+ * lettres[c] l'ensemble des états dans lesquels on arrive en lisant c.
+ *
+ * L'union des suivants est lue dans des tables précalculées (méthode de 
+ * Navarro et Raffinot) : le vecteur D est découpé en nb_blocs blocs de 
+ * 'largeur' bits, et pour chaque bloc b et chaque valeur v de ce bloc, 
+ * tables[ b * 2^largeur + v ] est l'union des suivants des états codés 
+ * par v. Une transition coûte donc une union de nb_mots mots par bloc 
+ * non nul de D : jamais plus d'une par état de D, et moins quand les 
+ * états de D sont voisins. Les blocs nuls ne sont pas lus, et un bloc 
+ * d'un seul état lit directement suivants[q]. La largeur est la plus 
+ * grande, parmi 8, 4 et 2 bits, pour laquelle les tables tiennent dans 
+ * AUTOMATE_BITS_TAILLE_TABLES octets.
+ */
+struct Automate_bits {
+	int nb_etats;
+	int nb_mots;
+	int* etats;
+	uint64_t* suivants;
+	uint64_t* lettres;
+	int largeur;
+	int nb_blocs;
+	uint64_t* tables;
+	uint64_t* initiaux;
+	uint64_t* finaux;
+};
+
+typedef struct Automate_bits Automate_bits;
+
+/**
+ * @brief Crée la simulation bit à bit d'un automate.
+ *
+ * @param automate Un automate.
+ * @return La simulation, ou NULL si l'automate n'est pas homogène ou 
+ *         possède plus de AUTOMATE_BITS_MAX_ETATS états.
+ */
+Automate_bits* creer_automate_bits( const Automate* automate );
+
+/**
+ * @brief Libère la mémoire d'une simulation bit à bit.
+ *
+ * @param automate La simulation à libérer.
+ */
+void liberer_automate_bits( Automate_bits* automate );
+
+/**
+ * @brief Remplace, en place, un ensemble d'états codé bit à bit par 
+ *        l'ensemble des états atteints en lisant un mot.
+ *
+ * Aucune allocation n'est faite.
+ *
+ * @param automate Une simulation bit à bit.
+ * @param etats Un vecteur de automate->nb_mots mots.
+ * @param mot Le mot à lire.
+ * @param longueur La longueur du mot, en octets.
+ */
+void delta_star_bits(
+	const Automate_bits* automate, uint64_t* etats, 
+	const char* mot, size_t longueur
+);
+
+/**
+ * @brief Renvoie 1 si le mot est reconnu et 0 sinon, sans allocation.
+ *
+ * @param automate Une simulation bit à bit.
+ * @param mot Le mot à reconnaître.
+ * @param longueur La longueur du mot, en octets.
+ * @return 1 ou 0.
+ */
+int le_mot_est_reconnu_bits(
+	const Automate_bits* automate, const char* mot, size_t longueur
+);
+
+/**
+ * @brief Code un ensemble d'états en un vecteur de bits.
+ *
+ * Les états qui ne sont pas des états de la simulation sont ignorés.
+ *
+ * @param automate Une simulation bit à bit.
+ * @param ensemble Un ensemble d'états.
+ * @param etats Un vecteur de automate->nb_mots mots, rempli par la fonction.
+ */
+void ensemble_vers_bits(
+	const Automate_bits* automate, const Ensemble* ensemble, uint64_t* etats
+);
+
+/**
+ * @brief Renvoie l'ensemble des états codé par un vecteur de bits.
+ *
+ * La mémoire de l'ensemble renvoyé est laissée à la charge de 
+ * l'utilisateur.
+ *
+ * @param automate Une simulation bit à bit.
+ * @param etats Un vecteur de automate->nb_mots mots.
+ * @return L'ensemble des états.
+ */
+Ensemble* bits_vers_ensemble( const Automate_bits* automate, const uint64_t* etats );
+
+#endif
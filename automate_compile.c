@@ -0,0 +1,235 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "automate_compile.h"
+#include "outils.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+Automate_compile* compiler_automate( const Automate* automate ){
+	if( ! est_deterministe( automate ) ){
+		Automate* det = creer_automate_deterministe( automate );
+		Automate_compile* res = compiler_automate( det );
+		liberer_automate( det );
+		return res;
+	}
+
+	// Les états sont indicés par leur numéro dans l'index des transitions,
+	// et les lettres équivalentes partagent une même colonne.
+	const Adjacence* adjacence = adjacence_automate( automate );
+	const int* etats = adjacence->etats;
+	int n = adjacence->nb_etats;
+	uint16_t classes[256];
+	int nb_classes = classes_de_lettres( automate, classes, NULL );
+	int k = nb_classes - 1;
+	int i, j;
+
+	// Transitions à plat (-1 : pas de transition) et transitions inverses
+	// au format CSR.
+	int* delta = xmalloc( ( (size_t) n * k + 1 ) * sizeof(int) );
+	for( i = 0; i < n*k; i++ ) delta[i] = -1;
+	for( i = 0; i < n; i++ ){
+		for( j = adjacence->debut[i]; j < adjacence->debut[i+1]; j++ ){
+			delta[ i*k + classes[ (unsigned char) adjacence->lettres[j] ] - 1 ] = 
+				adjacence->voisins[j];
+		}
+	}
+	int* nb_pred = xmalloc( ( n + 1 ) * sizeof(int) );
+	memset( nb_pred, 0, ( n + 1 ) * sizeof(int) );
+	for( i = 0; i < n*k; i++ ){
+		if( delta[i] >= 0 ) nb_pred[ delta[i] + 1 ]++;
+	}
+	for( i = 0; i < n; i++ ) nb_pred[i+1] += nb_pred[i];
+	int* pred = xmalloc( ( nb_pred[n] + 1 ) * sizeof(int) );
+	int* remplissage = xmalloc( ( n + 1 ) * sizeof(int) );
+	memcpy( remplissage, nb_pred, ( n + 1 ) * sizeof(int) );
+	for( i = 0; i < n*k; i++ ){
+		if( delta[i] >= 0 ) pred[ remplissage[ delta[i] ]++ ] = i / k;
+	}
+	xfree( remplissage );
+
+	// Les états vivants sont ceux depuis lesquels un état final est
+	// accessible : parcours en arrière depuis les états finaux.
+	char* vivant = xmalloc( n + 1 );
+	memset( vivant, 0, n + 1 );
+	int* pile = xmalloc( ( n + 1 ) * sizeof(int) );
+	int nb_pile = 0;
+	for( i = 0; i < n; i++ ){
+		if( est_un_etat_final_de_l_automate( automate, etats[i] ) ){
+			vivant[i] = 1;
+			pile[nb_pile++] = i;
+		}
+	}
+	while( nb_pile ){
+		int q = pile[--nb_pile];
+		for( j = nb_pred[q]; j < nb_pred[q+1]; j++ ){
+			if( ! vivant[ pred[j] ] ){
+				vivant[ pred[j] ] = 1;
+				pile[nb_pile++] = pred[j];
+			}
+		}
+	}
+
+	// Renumérotation : les états vivants, puis le puits.
+	int* numero = xmalloc( ( n + 1 ) * sizeof(int) );
+	int m = 0;
+	for( i = 0; i < n; i++ ){
+		numero[i] = vivant[i] ? m++ : -1;
+	}
+	for( i = 0; i < n; i++ ){
+		if( numero[i] < 0 ) numero[i] = m;
+	}
+
+	Automate_compile* res = xmalloc( sizeof(Automate_compile) );
+	res->nb_etats = m + 1;
+	res->nb_classes = nb_classes;
+	res->puits = m;
+	res->initial = numero[ numero_etat( 
+		adjacence, get_element( premier_iterateur_ensemble( get_initiaux( automate ) ) )
+	) ];
+	memcpy( res->classes, classes, sizeof(res->classes) );
+	res->transitions = xmalloc( 
+		(size_t) res->nb_etats * res->nb_classes * sizeof(int)
+	);
+	for( i = 0; i < res->nb_etats * res->nb_classes; i++ ){
+		res->transitions[i] = res->puits;
+	}
+	size_t nb_mots = ( res->nb_etats + 63 ) / 64;
+	res->finaux = xmalloc( nb_mots * sizeof(uint64_t) );
+	memset( res->finaux, 0, nb_mots * sizeof(uint64_t) );
+	for( i = 0; i < n; i++ ){
+		if( ! vivant[i] ) continue;
+		int q = numero[i];
+		int c;
+		for( c = 0; c < k; c++ ){
+			if( delta[ i*k + c ] >= 0 ){
+				res->transitions[ q * res->nb_classes + c + 1 ] = 
+					numero[ delta[ i*k + c ] ];
+			}
+		}
+		if( est_un_etat_final_de_l_automate( automate, etats[i] ) ){
+			res->finaux[ q / 64 ] |= (uint64_t) 1 << ( q % 64 );
+		}
+	}
+
+	xfree( numero ); xfree( pile ); xfree( vivant );
+	xfree( pred ); xfree( nb_pred ); xfree( delta );
+	return res;
+}
+
+void liberer_automate_compile( Automate_compile* automate ){
+	if( automate ){
+		xfree( automate->transitions );
+		xfree( automate->finaux );
+		xfree( automate );
+	}
+}
+
+int le_mot_est_reconnu_compile(
+	const Automate_compile* automate, const char* mot, size_t longueur
+){
+	const int* transitions = automate->transitions;
+	const uint16_t* classes = automate->classes;
+	const unsigned char* octets = (const unsigned char*) mot;
+	int nb_classes = automate->nb_classes;
+	int puits = automate->puits;
+	int etat = automate->initial;
+	size_t i;
+	for( i = 0; i < longueur; i++ ){
+		etat = transitions[ etat * nb_classes + classes[ octets[i] ] ];
+		if( etat == puits ) return 0;
+	}
+	return est_final_compile( automate, etat );
+}
+
+/*
+ * Le plus petit type entier non signé qui peut contenir tous les numéros 
+ * d'états.
+ */
+static const char* type_etat( const Automate_compile* automate ){
+	if( automate->nb_etats <= UINT8_MAX + 1 ) return "uint8_t";
+	if( automate->nb_etats <= UINT16_MAX + 1 ) return "uint16_t";
+	return "uint32_t";
+}
+
+void ecrire_automate_compile_c(
+	const Automate_compile* automate, const char* nom, FILE* sortie
+){
+	int q, c;
+	fprintf( sortie, 
+		"/* Fichier généré par ecrire_automate_compile_c() : "
+		"ne pas modifier. */\n\n"
+		"#include <stdbool.h>\n"
+		"#include <stddef.h>\n"
+		"#include <stdint.h>\n\n"
+	);
+
+	// Avec 257 classes, la dernière ne tient plus dans un octet.
+	fprintf( sortie, "static const %s %s_classes[256] = {", 
+		automate->nb_classes <= UINT8_MAX + 1 ? "uint8_t" : "uint16_t", nom 
+	);
+	for( c = 0; c < 256; c++ ){
+		fprintf( sortie, "%s%d,", c % 16 ? " " : "\n\t", automate->classes[c] );
+	}
+	fprintf( sortie, "\n};\n\n" );
+
+	fprintf( sortie, "static const %s %s_transitions[%d][%d] = {\n", 
+		type_etat( automate ), nom, automate->nb_etats, automate->nb_classes 
+	);
+	for( q = 0; q < automate->nb_etats; q++ ){
+		fprintf( sortie, "\t{" );
+		for( c = 0; c < automate->nb_classes; c++ ){
+			fprintf( sortie, "%s%d", c ? ", " : " ", 
+				automate->transitions[ q * automate->nb_classes + c ] 
+			);
+		}
+		fprintf( sortie, " },\n" );
+	}
+	fprintf( sortie, "};\n\n" );
+
+	fprintf( sortie, "static const bool %s_finaux[%d] = {", nom, automate->nb_etats );
+	for( q = 0; q < automate->nb_etats; q++ ){
+		fprintf( sortie, "%s%d,", q % 16 ? " " : "\n\t", 
+			est_final_compile( automate, q ) 
+		);
+	}
+	fprintf( sortie, "\n};\n\n" );
+
+	fprintf( sortie,
+		"bool %s( const char* mot, size_t longueur ){\n"
+		"\tconst unsigned char* octets = (const unsigned char*) mot;\n"
+		"\tunsigned etat = %d;\n"
+		"\tsize_t i;\n"
+		"\tfor( i = 0; i < longueur; i++ ){\n"
+		"\t\tetat = %s_transitions[etat][ %s_classes[ octets[i] ] ];\n"
+		"\t\tif( etat == %d ) return false;\n"
+		"\t}\n"
+		"\treturn %s_finaux[etat];\n"
+		"}\n",
+		nom, automate->initial, nom, nom, automate->puits, nom
+	);
+}
+
+void ecrire_automate_c( const Automate* automate, const char* nom, FILE* sortie ){
+	Automate_compile* compile = compiler_automate( automate );
+	ecrire_automate_compile_c( compile, nom, sortie );
+	liberer_automate_compile( compile );
+}
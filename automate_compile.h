@@ -0,0 +1,152 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file automate_compile.h */ 
+
+#ifndef __AUTOMATE_COMPILE_H__
+#define __AUTOMATE_COMPILE_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "automate.h"
+
+/**
+ * @brief Le type d'un automate compilé.
+ *
+ * Un automate compilé est une version figée d'un automate déterministe,
+ * destinée à reconnaître des mots le plus vite possible.
+ *
+ * - Les états sont renumérotés de 0 à nb_etats-1. L'état 'puits' 
+ *   regroupe tous les états depuis lesquels aucun état final n'est
+ *   accessible : dès qu'on l'atteint, le mot est rejeté.
+ * - Chaque octet est traduit en une classe par le tableau 'classes'. La 
+ *   classe 0 regroupe les octets qui ne sont pas dans l'alphabet et mène 
+ *   toujours dans le puits. Les lettres qui mènent aux mêmes états depuis
+ *   chaque état partagent une classe (voir classes_de_lettres()). Si les 
+ *   256 octets sont des lettres distinctes, il y a 257 classes : elles 
+ *   sont donc codées sur 16 bits.
+ * - L'état atteint depuis l'état q en lisant un octet de classe c est 
+ *   transitions[ q*nb_classes + c ].
+ * - L'état q est final si le bit q du tableau de bits 'finaux' vaut 1.
+ */
+struct Automate_compile {
+	int nb_etats;
+	int nb_classes;
+	int initial;
+	int puits;
+	uint16_t classes[256];
+	int* transitions;
+	uint64_t* finaux;
+};
+
+typedef struct Automate_compile Automate_compile;
+
+/**
+ * @brief Compile un automate.
+ *
+ * Si l'automate n'est pas déterministe, il est d'abord déterminisé.
+ *
+ * @param automate L'automate à compiler.
+ * @return L'automate compilé, à libérer avec liberer_automate_compile().
+ */
+Automate_compile* compiler_automate( const Automate* automate );
+
+/**
+ * @brief Libère la mémoire d'un automate compilé.
+ *
+ * @param automate L'automate compilé à libérer.
+ */
+void liberer_automate_compile( Automate_compile* automate );
+
+/**
+ * @brief Renvoie l'état atteint depuis un état en lisant un octet.
+ *
+ * @param automate Un automate compilé.
+ * @param etat L'état de départ.
+ * @param octet L'octet lu.
+ * @return L'état d'arrivée.
+ */
+static inline int transition_compile(
+	const Automate_compile* automate, int etat, unsigned char octet
+){
+	return automate->transitions[
+		etat * automate->nb_classes + automate->classes[octet]
+	];
+}
+
+/**
+ * @brief Renvoie 1 si l'état d'un automate compilé est final et 0 sinon.
+ *
+ * @param automate Un automate compilé.
+ * @param etat Un état.
+ * @return 1 ou 0.
+ */
+static inline int est_final_compile( const Automate_compile* automate, int etat ){
+	return ( automate->finaux[ etat / 64 ] >> ( etat % 64 ) ) & 1;
+}
+
+/**
+ * @brief Renvoie 1 si le mot est reconnu par l'automate compilé et 0 sinon.
+ *
+ * Le mot est donné par un pointeur et une longueur : il peut contenir des 
+ * octets nuls. Aucune allocation n'est faite.
+ *
+ * @param automate Un automate compilé.
+ * @param mot Le mot à reconnaître.
+ * @param longueur La longueur du mot, en octets.
+ * @return 1 ou 0.
+ */
+int le_mot_est_reconnu_compile(
+	const Automate_compile* automate, const char* mot, size_t longueur
+);
+
+/**
+ * @brief Écrit un fichier C autonome qui reconnaît le langage d'un 
+ *        automate compilé.
+ *
+ * Le fichier ne dépend que de la bibliothèque standard. Il contient les 
+ * tables de l'automate sous forme de tableaux 'static const' et une 
+ * fonction
+ *     bool nom( const char* mot, size_t longueur );
+ * qui renvoie true si le mot est reconnu. Aucune construction n'est donc 
+ * faite à l'exécution.
+ *
+ * @param automate Un automate compilé.
+ * @param nom Le nom de la fonction générée, qui doit être un identifiant C.
+ * @param sortie Le fichier dans lequel écrire, ouvert en écriture.
+ */
+void ecrire_automate_compile_c(
+	const Automate_compile* automate, const char* nom, FILE* sortie
+);
+
+/**
+ * @brief Compile un automate et écrit le fichier C correspondant.
+ *
+ * Voir compiler_automate() et ecrire_automate_compile_c().
+ *
+ * @param automate Un automate.
+ * @param nom Le nom de la fonction générée, qui doit être un identifiant C.
+ * @param sortie Le fichier dans lequel écrire, ouvert en écriture.
+ */
+void ecrire_automate_c( const Automate* automate, const char* nom, FILE* sortie );
+
+#endif
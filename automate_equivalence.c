@@ -0,0 +1,304 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "automate_equivalence.h"
+#include "dictionnaire.h"
+#include "outils.h"
+
+#include <string.h>
+
+/*
+ * Les ensembles du premier automate ont pour sommets, dans l'union-find, 
+ * les entiers pairs 2*id, et ceux du second les entiers impairs 2*id+1.
+ *
+ * Les couples à explorer sont rangés dans l'ordre de leur découverte. Le 
+ * couple k a été atteint depuis le couple parents[k] en lisant la lettre
+ * lettres[k] : c'est ce qui permet de reconstruire le contre-exemple.
+ */
+typedef struct {
+	Dictionnaire* ensembles[2];
+	int nb_sommets;
+	int* representants;
+	int nb_couples;
+	int capacite;
+	int* premiers;
+	int* seconds;
+	int* parents;
+	char* lettres;
+} Exploration;
+
+static void agrandir_union_find( Exploration* exploration ){
+	int n = 2 * taille_dictionnaire( exploration->ensembles[0] );
+	int m = 2 * taille_dictionnaire( exploration->ensembles[1] );
+	if( m > n ) n = m;
+	if( n <= exploration->nb_sommets ) return;
+	exploration->representants = xrealloc( 
+		exploration->representants, n * sizeof(int) 
+	);
+	int i;
+	for( i = exploration->nb_sommets; i < n; i++ ){
+		exploration->representants[i] = i;
+	}
+	exploration->nb_sommets = n;
+}
+
+static int trouver( Exploration* exploration, int sommet ){
+	int* representants = exploration->representants;
+	while( representants[sommet] != sommet ){
+		representants[sommet] = representants[ representants[sommet] ];
+		sommet = representants[sommet];
+	}
+	return sommet;
+}
+
+static void ajouter_couple( 
+	Exploration* exploration, Ensemble* x, Ensemble* y, int parent, char lettre
+){
+	if( exploration->nb_couples == exploration->capacite ){
+		exploration->capacite *= 2;
+		size_t n = exploration->capacite;
+		exploration->premiers = xrealloc( exploration->premiers, n * sizeof(int) );
+		exploration->seconds = xrealloc( exploration->seconds, n * sizeof(int) );
+		exploration->parents = xrealloc( exploration->parents, n * sizeof(int) );
+		exploration->lettres = xrealloc( exploration->lettres, n );
+	}
+	int k = exploration->nb_couples++;
+	exploration->premiers[k] = identifiant_ensemble( exploration->ensembles[0], x, NULL );
+	exploration->seconds[k] = identifiant_ensemble( exploration->ensembles[1], y, NULL );
+	exploration->parents[k] = parent;
+	exploration->lettres[k] = lettre;
+	agrandir_union_find( exploration );
+}
+
+static int contient_un_etat_final( const Automate* automate, const Ensemble* ensemble ){
+	Ensemble_iterateur it;
+	for(
+		it = premier_iterateur_ensemble( ensemble );
+		! iterateur_ensemble_est_vide( it );
+		it = iterateur_suivant_ensemble( it )
+	){
+		if( est_un_etat_final_de_l_automate( automate, get_element( it ) ) ){
+			return 1;
+		}
+	}
+	return 0;
+}
+
+/*
+ * Renvoie le mot qui mène au couple, en remontant les parents.
+ */
+static char* reconstruire_mot( const int* parents, const char* lettres, int couple ){
+	int longueur = 0, k;
+	for( k = couple; parents[k] >= 0; k = parents[k] ){
+		longueur++;
+	}
+	char* mot = xmalloc( longueur + 1 );
+	mot[longueur] = '\0';
+	for( k = couple; parents[k] >= 0; k = parents[k] ){
+		mot[ --longueur ] = lettres[k];
+	}
+	return mot;
+}
+
+int automates_equivalents(
+	const Automate* automate_1, const Automate* automate_2, 
+	char** contre_exemple
+){
+	Exploration exploration;
+	exploration.ensembles[0] = creer_dictionnaire();
+	exploration.ensembles[1] = creer_dictionnaire();
+	exploration.nb_sommets = 0;
+	exploration.representants = NULL;
+	exploration.nb_couples = 0;
+	exploration.capacite = 16;
+	exploration.premiers = xmalloc( exploration.capacite * sizeof(int) );
+	exploration.seconds = xmalloc( exploration.capacite * sizeof(int) );
+	exploration.parents = xmalloc( exploration.capacite * sizeof(int) );
+	exploration.lettres = xmalloc( exploration.capacite );
+
+	Ensemble* alphabet = creer_union_ensemble( 
+		get_alphabet( automate_1 ), get_alphabet( automate_2 ) 
+	);
+
+	ajouter_couple( 
+		&exploration, 
+		copier_ensemble( get_initiaux( automate_1 ) ),
+		copier_ensemble( get_initiaux( automate_2 ) ),
+		-1, '\0'
+	);
+
+	int res = 1;
+	int k;
+	for( k = 0; k < exploration.nb_couples; k++ ){
+		int x = exploration.premiers[k];
+		int y = exploration.seconds[k];
+		int rx = trouver( &exploration, 2 * x );
+		int ry = trouver( &exploration, 2 * y + 1 );
+		if( rx == ry ) continue;
+
+		const Ensemble* ex = ensemble_de_identifiant( exploration.ensembles[0], x );
+		const Ensemble* ey = ensemble_de_identifiant( exploration.ensembles[1], y );
+		if( 
+			contient_un_etat_final( automate_1, ex ) 
+			!= contient_un_etat_final( automate_2, ey )
+		){
+			res = 0;
+			if( contre_exemple ){
+				*contre_exemple = reconstruire_mot( 
+					exploration.parents, exploration.lettres, k 
+				);
+			}
+			break;
+		}
+		exploration.representants[rx] = ry;
+
+		Ensemble_iterateur it;
+		for(
+			it = premier_iterateur_ensemble( alphabet );
+			! iterateur_ensemble_est_vide( it );
+			it = iterateur_suivant_ensemble( it )
+		){
+			char lettre = (char) get_element( it );
+			ajouter_couple( 
+				&exploration,
+				delta( automate_1, ex, lettre ),
+				delta( automate_2, ey, lettre ),
+				k, lettre
+			);
+		}
+	}
+
+	liberer_ensemble( alphabet );
+	xfree( exploration.premiers );
+	xfree( exploration.seconds );
+	xfree( exploration.parents );
+	xfree( exploration.lettres );
+	xfree( exploration.representants );
+	liberer_dictionnaire( exploration.ensembles[0] );
+	liberer_dictionnaire( exploration.ensembles[1] );
+	return res;
+}
+
+/*
+ * Parcourt en largeur le produit des déterminisés des deux automates et 
+ * renvoie le premier mot qui mène à un couple (X, Y) tel que X est final 
+ * et Y ne l'est pas, ou, si 'inclusion' vaut 0, tel qu'un seul des deux
+ * est final.
+ *
+ * Un couple (x, y) d'identifiants d'ensembles est lui-même rangé dans un 
+ * dictionnaire, sous la forme de l'ensemble {2x, 2y+1} : son identifiant
+ * donne l'ordre du parcours, et le dictionnaire sert aussi de file.
+ */
+static char* chercher_mot_distinguant( 
+	const Automate* automate_1, const Automate* automate_2, int inclusion
+){
+	Dictionnaire* ensembles_1 = creer_dictionnaire();
+	Dictionnaire* ensembles_2 = creer_dictionnaire();
+	Dictionnaire* couples = creer_dictionnaire();
+	int capacite = 16;
+	int* parents = xmalloc( capacite * sizeof(int) );
+	char* lettres = xmalloc( capacite );
+	char* res = NULL;
+
+	Ensemble* alphabet = creer_union_ensemble( 
+		get_alphabet( automate_1 ), get_alphabet( automate_2 ) 
+	);
+
+	Ensemble* couple = creer_ensemble( NULL, NULL, NULL );
+	ajouter_element( couple, 2 * identifiant_ensemble( 
+		ensembles_1, copier_ensemble( get_initiaux( automate_1 ) ), NULL 
+	) );
+	ajouter_element( couple, 2 * identifiant_ensemble( 
+		ensembles_2, copier_ensemble( get_initiaux( automate_2 ) ), NULL 
+	) + 1 );
+	identifiant_ensemble( couples, couple, NULL );
+	parents[0] = -1;
+	lettres[0] = '\0';
+
+	int k;
+	for( k = 0; k < taille_dictionnaire( couples ); k++ ){
+		Ensemble_iterateur it = premier_iterateur_ensemble( 
+			ensemble_de_identifiant( couples, k ) 
+		);
+		int u = get_element( it );
+		int v = get_element( iterateur_suivant_ensemble( it ) );
+		int x = ( u % 2 == 0 ) ? u / 2 : v / 2;
+		int y = ( u % 2 == 0 ) ? v / 2 : u / 2;
+		const Ensemble* ex = ensemble_de_identifiant( ensembles_1, x );
+		const Ensemble* ey = ensemble_de_identifiant( ensembles_2, y );
+		int final_1 = contient_un_etat_final( automate_1, ex );
+		int final_2 = contient_un_etat_final( automate_2, ey );
+		if( final_1 != final_2 && ( final_1 || ! inclusion ) ){
+			res = reconstruire_mot( parents, lettres, k );
+			break;
+		}
+
+		for(
+			it = premier_iterateur_ensemble( alphabet );
+			! iterateur_ensemble_est_vide( it );
+			it = iterateur_suivant_ensemble( it )
+		){
+			char lettre = (char) get_element( it );
+			couple = creer_ensemble( NULL, NULL, NULL );
+			ajouter_element( couple, 2 * identifiant_ensemble( 
+				ensembles_1, delta( automate_1, ex, lettre ), NULL 
+			) );
+			ajouter_element( couple, 2 * identifiant_ensemble( 
+				ensembles_2, delta( automate_2, ey, lettre ), NULL 
+			) + 1 );
+			int nouveau;
+			int id = identifiant_ensemble( couples, couple, &nouveau );
+			if( ! nouveau ) continue;
+			if( id == capacite ){
+				capacite *= 2;
+				parents = xrealloc( parents, capacite * sizeof(int) );
+				lettres = xrealloc( lettres, capacite );
+			}
+			parents[id] = k;
+			lettres[id] = lettre;
+		}
+	}
+
+	liberer_ensemble( alphabet );
+	xfree( parents );
+	xfree( lettres );
+	liberer_dictionnaire( couples );
+	liberer_dictionnaire( ensembles_1 );
+	liberer_dictionnaire( ensembles_2 );
+	return res;
+}
+
+char* mot_distinguant( const Automate* automate_1, const Automate* automate_2 ){
+	return chercher_mot_distinguant( automate_1, automate_2, 0 );
+}
+
+int automate_est_inclus(
+	const Automate* automate_1, const Automate* automate_2, 
+	char** contre_exemple
+){
+	char* mot = chercher_mot_distinguant( automate_1, automate_2, 1 );
+	if( ! mot ) return 1;
+	if( contre_exemple ){
+		*contre_exemple = mot;
+	}else{
+		xfree( mot );
+	}
+	return 0;
+}
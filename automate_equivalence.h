@@ -0,0 +1,92 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file automate_equivalence.h */ 
+
+#ifndef __AUTOMATE_EQUIVALENCE_H__
+#define __AUTOMATE_EQUIVALENCE_H__
+
+#include "automate.h"
+
+/**
+ * @brief Renvoie 1 si deux automates reconnaissent le même langage et 0 
+ *        sinon.
+ *
+ * Les automates n'ont besoin d'être ni déterministes, ni minimaux. 
+ * L'algorithme de Hopcroft et Karp explore, en largeur, les couples 
+ * (X, Y) d'ensembles d'états atteints par un même mot dans le premier et
+ * le second automate, en partant des états initiaux. Une structure 
+ * union-find regroupe les ensembles dont on sait déjà qu'ils doivent 
+ * reconnaître le même langage : un couple dont les deux ensembles sont 
+ * déjà dans la même classe n'est pas exploré. Dès qu'un couple contient 
+ * un seul ensemble final, l'exploration s'arrête.
+ *
+ * Seuls les ensembles accessibles sont construits, et aucun automate 
+ * n'est créé.
+ *
+ * @param automate_1 Le premier automate.
+ * @param automate_2 Le second automate.
+ * @param contre_exemple Si ce pointeur est non NULL et que les langages 
+ *        sont différents, il reçoit un mot reconnu par un seul des deux 
+ *        automates, à libérer avec xfree().
+ * @return 1 ou 0.
+ */
+int automates_equivalents(
+	const Automate* automate_1, const Automate* automate_2, 
+	char** contre_exemple
+);
+
+/**
+ * @brief Renvoie un plus court mot reconnu par un seul des deux 
+ *        automates, ou NULL s'ils reconnaissent le même langage.
+ *
+ * Le produit des déterminisés des deux automates est parcouru en largeur
+ * depuis le couple des ensembles d'états initiaux, sans être construit : 
+ * chaque couple d'ensembles est calculé quand il est atteint, et le 
+ * parcours s'arrête au premier couple dont un seul ensemble est final. 
+ * Contrairement à automates_equivalents(), aucun couple n'est évité par 
+ * union-find : le mot trouvé est donc de longueur minimale.
+ *
+ * @param automate_1 Le premier automate.
+ * @param automate_2 Le second automate.
+ * @return Le mot, à libérer avec xfree(), ou NULL.
+ */
+char* mot_distinguant( const Automate* automate_1, const Automate* automate_2 );
+
+/**
+ * @brief Renvoie 1 si le langage du premier automate est inclus dans 
+ *        celui du second et 0 sinon.
+ *
+ * Le parcours est celui de mot_distinguant(), qui s'arrête au premier 
+ * couple dont seul le premier ensemble est final.
+ *
+ * @param automate_1 Le premier automate.
+ * @param automate_2 Le second automate.
+ * @param contre_exemple Si ce pointeur est non NULL et que le langage 
+ *        n'est pas inclus, il reçoit un plus court mot reconnu par le 
+ *        premier automate et pas par le second, à libérer avec xfree().
+ * @return 1 ou 0.
+ */
+int automate_est_inclus(
+	const Automate* automate_1, const Automate* automate_2, 
+	char** contre_exemple
+);
+
+#endif
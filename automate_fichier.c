@@ -0,0 +1,396 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "automate_fichier.h"
+#include "outils.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define MAGIE "AUTO"
+#define BOUTISME 0x01020304
+
+static int comparer_int32( const void* a, const void* b ){
+	int32_t x = *(const int32_t*) a;
+	int32_t y = *(const int32_t*) b;
+	return ( x > y ) - ( x < y );
+}
+
+static int32_t indice( const int32_t* tableau, int n, int32_t valeur ){
+	const int32_t* trouve = bsearch( 
+		&valeur, tableau, n, sizeof(int32_t), comparer_int32 
+	);
+	return trouve - tableau;
+}
+
+static int32_t* ensemble_vers_tableau( const Ensemble* ensemble ){
+	int32_t* res = xmalloc( ( taille_ensemble( ensemble ) + 1 ) * sizeof(int32_t) );
+	int i = 0;
+	Ensemble_iterateur it;
+	for(
+		it = premier_iterateur_ensemble( ensemble );
+		! iterateur_ensemble_est_vide( it );
+		it = iterateur_suivant_ensemble( it )
+	){
+		res[i++] = get_element( it );
+	}
+	return res;
+}
+
+/*
+ * Remplace chaque état du tableau par son indice dans 'etats'.
+ */
+static void etats_vers_indices( 
+	int32_t* tableau, int taille, const int32_t* etats, int nb_etats 
+){
+	int i;
+	for( i = 0; i < taille; i++ ){
+		tableau[i] = indice( etats, nb_etats, tableau[i] );
+	}
+}
+
+int sauver_automate( const Automate* automate, const char* chemin ){
+	Automate_entete entete;
+	memset( &entete, 0, sizeof(entete) );
+	memcpy( entete.magie, MAGIE, 4 );
+	entete.version = AUTOMATE_FICHIER_VERSION;
+	entete.boutisme = BOUTISME;
+	entete.deterministe = est_deterministe( automate );
+	int n = entete.nb_etats = taille_ensemble( get_etats( automate ) );
+	int k = entete.nb_lettres = taille_ensemble( get_alphabet( automate ) );
+	entete.nb_initiaux = taille_ensemble( get_initiaux( automate ) );
+	entete.nb_finaux = taille_ensemble( get_finaux( automate ) );
+
+	int32_t* etats = ensemble_vers_tableau( get_etats( automate ) );
+	int32_t* lettres = ensemble_vers_tableau( get_alphabet( automate ) );
+	int32_t* initiaux = ensemble_vers_tableau( get_initiaux( automate ) );
+	int32_t* finaux = ensemble_vers_tableau( get_finaux( automate ) );
+	etats_vers_indices( initiaux, entete.nb_initiaux, etats, n );
+	etats_vers_indices( finaux, entete.nb_finaux, etats, n );
+
+	int m = nombre_de_transitions( automate );
+	entete.nb_transitions = m;
+	int32_t* debut = xmalloc( ( n + 1 ) * sizeof(int32_t) );
+	int32_t* lettre = xmalloc( ( m + 1 ) * sizeof(int32_t) );
+	int32_t* fin = xmalloc( ( m + 1 ) * sizeof(int32_t) );
+	int q, c, t = 0;
+	for( q = 0; q < n; q++ ){
+		debut[q] = t;
+		for( c = 0; c < k; c++ ){
+			Ensemble_iterateur it;
+			for(
+				it = premier_iterateur_ensemble( 
+					voisins( automate, etats[q], lettres[c] ) 
+				);
+				! iterateur_ensemble_est_vide( it );
+				it = iterateur_suivant_ensemble( it )
+			){
+				lettre[t] = c;
+				fin[t] = indice( etats, n, get_element( it ) );
+				t++;
+			}
+		}
+	}
+	debut[n] = t;
+
+	int res = 0;
+	FILE* f = fopen( chemin, "wb" );
+	if( f ){
+		res = 
+			fwrite( &entete, sizeof(entete), 1, f ) == 1
+			&& fwrite( etats, sizeof(int32_t), n, f ) == n
+			&& fwrite( lettres, sizeof(int32_t), k, f ) == k
+			&& fwrite( initiaux, sizeof(int32_t), entete.nb_initiaux, f ) 
+				== entete.nb_initiaux
+			&& fwrite( finaux, sizeof(int32_t), entete.nb_finaux, f ) 
+				== entete.nb_finaux
+			&& fwrite( debut, sizeof(int32_t), n + 1, f ) == n + 1
+			&& fwrite( lettre, sizeof(int32_t), m, f ) == m
+			&& fwrite( fin, sizeof(int32_t), m, f ) == m;
+		res = ( fclose( f ) == 0 ) && res;
+	}
+
+	xfree( fin ); xfree( lettre ); xfree( debut );
+	xfree( finaux ); xfree( initiaux ); xfree( lettres ); xfree( etats );
+	return res;
+}
+
+static int est_croissant( const int32_t* tableau, uint32_t n ){
+	uint32_t i;
+	for( i = 1; i < n; i++ ){
+		if( tableau[i-1] >= tableau[i] ) return 0;
+	}
+	return 1;
+}
+
+static int est_dans_intervalle( 
+	const int32_t* tableau, uint32_t n, int32_t min, int32_t max 
+){
+	uint32_t i;
+	for( i = 0; i < n; i++ ){
+		if( tableau[i] < min || tableau[i] > max ) return 0;
+	}
+	return 1;
+}
+
+/*
+ * Vérifie le contenu d'un fichier d'automate et fait pointer les tableaux 
+ * de 'res' dans 'donnees'. Renvoie 1 si le fichier est valide et 0 sinon.
+ */
+static int decoder( const void* donnees, size_t taille, Automate_projete* res ){
+	const Automate_entete* e = donnees;
+	if( 
+		taille < sizeof(Automate_entete)
+		|| memcmp( e->magie, MAGIE, 4 ) != 0
+		|| e->version != AUTOMATE_FICHIER_VERSION
+		|| e->boutisme != BOUTISME
+		|| e->nb_lettres > 256
+		|| e->nb_etats >= INT32_MAX
+		|| e->nb_transitions >= INT32_MAX
+	){
+		return 0;
+	}
+	uint64_t nb_entiers = 
+		(uint64_t) e->nb_etats + e->nb_lettres + e->nb_initiaux + 
+		e->nb_finaux + e->nb_etats + 1 + 2 * (uint64_t) e->nb_transitions;
+	if( taille != sizeof(Automate_entete) + nb_entiers * sizeof(int32_t) ){
+		return 0;
+	}
+	int32_t n = e->nb_etats;
+	res->entete = e;
+	res->etats = (const int32_t*) ( e + 1 );
+	res->lettres = res->etats + e->nb_etats;
+	res->initiaux = res->lettres + e->nb_lettres;
+	res->finaux = res->initiaux + e->nb_initiaux;
+	res->debut = res->finaux + e->nb_finaux;
+	res->lettre = res->debut + e->nb_etats + 1;
+	res->fin = res->lettre + e->nb_transitions;
+
+	if(
+		! est_croissant( res->etats, e->nb_etats )
+		|| ! est_croissant( res->lettres, e->nb_lettres )
+		|| ! est_dans_intervalle( res->lettres, e->nb_lettres, -128, 255 )
+		|| ! est_croissant( res->initiaux, e->nb_initiaux )
+		|| ! est_dans_intervalle( res->initiaux, e->nb_initiaux, 0, n - 1 )
+		|| ! est_croissant( res->finaux, e->nb_finaux )
+		|| ! est_dans_intervalle( res->finaux, e->nb_finaux, 0, n - 1 )
+		|| res->debut[0] != 0
+		|| res->debut[n] != e->nb_transitions
+		|| ! est_dans_intervalle( res->debut, n + 1, 0, (int32_t) e->nb_transitions )
+		|| ! est_dans_intervalle( res->lettre, e->nb_transitions, 0, (int32_t) e->nb_lettres - 1 )
+		|| ! est_dans_intervalle( res->fin, e->nb_transitions, 0, n - 1 )
+		|| ( e->deterministe && e->nb_initiaux > 1 )
+	){
+		return 0;
+	}
+	// Les bornes des transitions de tous les états sont vérifiées avant 
+	// de lire leurs lettres.
+	int32_t q, t;
+	for( q = 0; q < n; q++ ){
+		if( res->debut[q] > res->debut[q+1] ) return 0;
+	}
+	for( q = 0; q < n; q++ ){
+		for( t = res->debut[q] + 1; t < res->debut[q+1]; t++ ){
+			// Les lettres d'un état déterministe sont toutes différentes.
+			if( res->lettre[t-1] > res->lettre[t] ) return 0;
+			if( e->deterministe && res->lettre[t-1] == res->lettre[t] ) return 0;
+		}
+	}
+
+	int c;
+	for( c = 0; c < 256; c++ ) res->indices[c] = -1;
+	for( c = 0; c < e->nb_lettres; c++ ){
+		unsigned char octet = (unsigned char) res->lettres[c];
+		if( res->indices[octet] >= 0 ) return 0;
+		res->indices[octet] = c;
+	}
+	return 1;
+}
+
+Automate* charger_automate( const char* chemin ){
+	FILE* f = fopen( chemin, "rb" );
+	if( ! f ) return NULL;
+	long taille = -1;
+	if( fseek( f, 0, SEEK_END ) == 0 ){
+		taille = ftell( f );
+	}
+	if( taille < 0 || fseek( f, 0, SEEK_SET ) != 0 ){
+		fclose( f );
+		return NULL;
+	}
+	void* donnees = xmalloc( taille + 1 );
+	int lu = fread( donnees, 1, taille, f ) == (size_t) taille;
+	fclose( f );
+
+	Automate* res = NULL;
+	Automate_projete p;
+	if( lu && decoder( donnees, taille, &p ) ){
+		res = creer_automate();
+		uint32_t i;
+		int32_t q, t;
+		for( i = 0; i < p.entete->nb_etats; i++ ){
+			ajouter_etat( res, p.etats[i] );
+		}
+		for( i = 0; i < p.entete->nb_lettres; i++ ){
+			ajouter_lettre( res, (char) p.lettres[i] );
+		}
+		for( i = 0; i < p.entete->nb_initiaux; i++ ){
+			ajouter_etat_initial( res, p.etats[ p.initiaux[i] ] );
+		}
+		for( i = 0; i < p.entete->nb_finaux; i++ ){
+			ajouter_etat_final( res, p.etats[ p.finaux[i] ] );
+		}
+		for( q = 0; q < p.entete->nb_etats; q++ ){
+			for( t = p.debut[q]; t < p.debut[q+1]; t++ ){
+				ajouter_transition( 
+					res, p.etats[q], (char) p.lettres[ p.lettre[t] ], 
+					p.etats[ p.fin[t] ] 
+				);
+			}
+		}
+	}
+	xfree( donnees );
+	return res;
+}
+
+Automate_projete* projeter_automate( const char* chemin ){
+	int fd = open( chemin, O_RDONLY );
+	if( fd < 0 ) return NULL;
+	struct stat st;
+	if( fstat( fd, &st ) != 0 || st.st_size <= 0 ){
+		close( fd );
+		return NULL;
+	}
+	void* donnees = mmap( NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0 );
+	close( fd );
+	if( donnees == MAP_FAILED ) return NULL;
+
+	Automate_projete* res = xmalloc( sizeof(Automate_projete) );
+	res->donnees = donnees;
+	res->taille = st.st_size;
+	if( ! decoder( donnees, st.st_size, res ) ){
+		liberer_automate_projete( res );
+		return NULL;
+	}
+	return res;
+}
+
+void liberer_automate_projete( Automate_projete* automate ){
+	if( automate ){
+		munmap( automate->donnees, automate->taille );
+		xfree( automate );
+	}
+}
+
+/*
+ * Renvoie l'indice de la transition de l'état q par la lettre c, ou -1.
+ */
+static int32_t chercher_transition( const Automate_projete* automate, int32_t q, int c ){
+	int32_t bas = automate->debut[q], haut = automate->debut[q+1];
+	while( bas < haut ){
+		int32_t milieu = bas + ( haut - bas ) / 2;
+		if( automate->lettre[milieu] < c ){
+			bas = milieu + 1;
+		}else{
+			haut = milieu;
+		}
+	}
+	if( bas < automate->debut[q+1] && automate->lettre[bas] == c ) return bas;
+	return -1;
+}
+
+static int est_final_projete( const Automate_projete* automate, int32_t q ){
+	return bsearch( 
+		&q, automate->finaux, automate->entete->nb_finaux, sizeof(int32_t), 
+		comparer_int32
+	) != NULL;
+}
+
+int le_mot_est_reconnu_projete(
+	const Automate_projete* automate, const char* mot, size_t longueur
+){
+	const unsigned char* octets = (const unsigned char*) mot;
+	const Automate_entete* e = automate->entete;
+	size_t i;
+	if( e->deterministe ){
+		if( e->nb_initiaux == 0 ) return 0;
+		int32_t q = automate->initiaux[0];
+		for( i = 0; i < longueur; i++ ){
+			int c = automate->indices[ octets[i] ];
+			int32_t t = c < 0 ? -1 : chercher_transition( automate, q, c );
+			if( t < 0 ) return 0;
+			q = automate->fin[t];
+		}
+		return est_final_projete( automate, q );
+	}
+
+	// Simulation de l'automate non déterministe avec deux tableaux de bits.
+	size_t nb_mots = ( e->nb_etats + 63 ) / 64 + 1;
+	uint64_t* bits = xmalloc( 2 * nb_mots * sizeof(uint64_t) );
+	uint64_t* courant = bits;
+	uint64_t* suivant = bits + nb_mots;
+	memset( courant, 0, nb_mots * sizeof(uint64_t) );
+	uint32_t j;
+	for( j = 0; j < e->nb_initiaux; j++ ){
+		int32_t q = automate->initiaux[j];
+		courant[ q / 64 ] |= (uint64_t) 1 << ( q % 64 );
+	}
+	int vivant = e->nb_initiaux > 0;
+	for( i = 0; i < longueur && vivant; i++ ){
+		int c = automate->indices[ octets[i] ];
+		memset( suivant, 0, nb_mots * sizeof(uint64_t) );
+		vivant = 0;
+		size_t k;
+		for( k = 0; c >= 0 && k < nb_mots; k++ ){
+			uint64_t m = courant[k];
+			while( m ){
+				int32_t q = 64 * k + __builtin_ctzll( m );
+				m &= m - 1;
+				int32_t t = chercher_transition( automate, q, c );
+				for( ; t >= 0 && t < automate->debut[q+1] && automate->lettre[t] == c; t++ ){
+					int32_t f = automate->fin[t];
+					suivant[ f / 64 ] |= (uint64_t) 1 << ( f % 64 );
+					vivant = 1;
+				}
+			}
+		}
+		uint64_t* echange = courant;
+		courant = suivant;
+		suivant = echange;
+	}
+	int res = 0;
+	for( j = 0; j < e->nb_finaux && vivant; j++ ){
+		int32_t q = automate->finaux[j];
+		if( ( courant[ q / 64 ] >> ( q % 64 ) ) & 1 ){
+			res = 1;
+			break;
+		}
+	}
+	xfree( bits );
+	return res;
+}
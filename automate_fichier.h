@@ -0,0 +1,140 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file automate_fichier.h */ 
+
+#ifndef __AUTOMATE_FICHIER_H__
+#define __AUTOMATE_FICHIER_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "automate.h"
+
+/**
+ * @brief Version du format binaire écrit par sauver_automate().
+ */
+#define AUTOMATE_FICHIER_VERSION 1
+
+/**
+ * @brief L'en-tête d'un fichier d'automate.
+ *
+ * Le fichier est une suite d'entiers 32 bits dans le boutisme de la 
+ * machine qui l'a écrit (le champ 'boutisme' vaut 0x01020304 et permet de 
+ * le vérifier). Après l'en-tête viennent, dans l'ordre :
+ * - etats[nb_etats] : les états, triés ;
+ * - lettres[nb_lettres] : les lettres, triées ;
+ * - initiaux[nb_initiaux] et finaux[nb_finaux] : les indices, dans 
+ *   'etats', des états initiaux et finaux, triés ;
+ * - debut[nb_etats+1], lettre[nb_transitions], fin[nb_transitions] : les 
+ *   transitions au format CSR. Les transitions issues de l'état d'indice 
+ *   q sont celles d'indices debut[q] à debut[q+1]-1, triées par lettre 
+ *   puis par fin ; 'lettre' et 'fin' sont des indices dans 'lettres' et 
+ *   'etats'.
+ */
+typedef struct {
+	char magie[4];
+	uint32_t version;
+	uint32_t boutisme;
+	uint32_t deterministe;
+	uint32_t nb_etats;
+	uint32_t nb_lettres;
+	uint32_t nb_initiaux;
+	uint32_t nb_finaux;
+	uint32_t nb_transitions;
+} Automate_entete;
+
+/**
+ * @brief Le type d'un automate projeté en mémoire, en lecture seule.
+ *
+ * Les tableaux pointent directement dans les pages du fichier projeté.
+ */
+struct Automate_projete {
+	void* donnees;
+	size_t taille;
+	const Automate_entete* entete;
+	const int32_t* etats;
+	const int32_t* lettres;
+	const int32_t* initiaux;
+	const int32_t* finaux;
+	const int32_t* debut;
+	const int32_t* lettre;
+	const int32_t* fin;
+	// Indice de chaque octet dans 'lettres', ou -1.
+	int16_t indices[256];
+};
+
+typedef struct Automate_projete Automate_projete;
+
+/**
+ * @brief Écrit un automate dans un fichier binaire.
+ *
+ * @param automate L'automate à écrire.
+ * @param chemin Le chemin du fichier.
+ * @return 1 en cas de succès et 0 sinon.
+ */
+int sauver_automate( const Automate* automate, const char* chemin );
+
+/**
+ * @brief Lit un automate écrit par sauver_automate().
+ *
+ * @param chemin Le chemin du fichier.
+ * @return L'automate, ou NULL si le fichier n'a pas pu être lu ou n'est 
+ *         pas un fichier d'automate valide.
+ */
+Automate* charger_automate( const char* chemin );
+
+/**
+ * @brief Projette en mémoire, en lecture seule, un fichier écrit par 
+ *        sauver_automate().
+ *
+ * Le fichier est vérifié mais aucune structure n'est construite : la 
+ * reconnaissance se fait directement dans les pages projetées.
+ *
+ * @param chemin Le chemin du fichier.
+ * @return L'automate projeté, à libérer avec liberer_automate_projete(), 
+ *         ou NULL si le fichier n'est pas valide.
+ */
+Automate_projete* projeter_automate( const char* chemin );
+
+/**
+ * @brief Libère un automate projeté et supprime la projection.
+ *
+ * @param automate L'automate projeté.
+ */
+void liberer_automate_projete( Automate_projete* automate );
+
+/**
+ * @brief Renvoie 1 si le mot est reconnu par un automate projeté et 0 
+ *        sinon.
+ *
+ * Si l'automate est déterministe, aucune allocation n'est faite. Sinon,
+ * les ensembles d'états courants sont alloués une fois par appel.
+ *
+ * @param automate Un automate projeté.
+ * @param mot Le mot à reconnaître.
+ * @param longueur La longueur du mot, en octets.
+ * @return 1 ou 0.
+ */
+int le_mot_est_reconnu_projete(
+	const Automate_projete* automate, const char* mot, size_t longueur
+);
+
+#endif
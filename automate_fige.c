@@ -0,0 +1,197 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "automate_fige.h"
+#include "outils.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+static int comparer_int( const void* a, const void* b ){
+	int x = *(const int*) a;
+	int y = *(const int*) b;
+	return ( x > y ) - ( x < y );
+}
+
+Automate_fige* figer_automate( const Automate* automate ){
+	const Adjacence* adj = adjacence_automate( automate );
+	int n = adj->nb_etats;
+	int m = adj->nb_transitions;
+	int nb_initiaux = taille_ensemble( get_initiaux( automate ) );
+	int taille_alphabet = taille_ensemble( get_alphabet( automate ) );
+	size_t nb_mots = ( n + 63 ) / 64;
+
+	// Un seul bloc : la structure, puis les tableaux, du plus aligné au 
+	// moins aligné.
+	size_t taille_structure = 
+		( sizeof(Automate_fige) + sizeof(uint64_t) - 1 ) 
+		/ sizeof(uint64_t) * sizeof(uint64_t);
+	size_t taille = taille_structure
+		+ nb_mots * sizeof(uint64_t)
+		+ ( (size_t) n + ( n + 1 ) + m + nb_initiaux ) * sizeof(int)
+		+ m + taille_alphabet;
+	char* bloc = xmalloc( taille );
+	Automate_fige* res = (Automate_fige*) bloc;
+	char* libre = bloc + taille_structure;
+
+	uint64_t* finaux = (uint64_t*) libre;
+	libre += nb_mots * sizeof(uint64_t);
+	int* etats = (int*) libre;
+	libre += n * sizeof(int);
+	int* debut = (int*) libre;
+	libre += ( n + 1 ) * sizeof(int);
+	int* voisins = (int*) libre;
+	libre += m * sizeof(int);
+	int* initiaux = (int*) libre;
+	libre += nb_initiaux * sizeof(int);
+	char* lettres = libre;
+	libre += m;
+	char* alphabet = libre;
+
+	memcpy( etats, adj->etats, n * sizeof(int) );
+	memcpy( debut, adj->debut, ( n + 1 ) * sizeof(int) );
+	memcpy( voisins, adj->voisins, m * sizeof(int) );
+	memcpy( lettres, adj->lettres, m );
+	memset( finaux, 0, nb_mots * sizeof(uint64_t) );
+	int i;
+	for( i = 0; i < n; i++ ){
+		if( est_un_etat_final_de_l_automate( automate, etats[i] ) ){
+			finaux[ i / 64 ] |= (uint64_t) 1 << ( i % 64 );
+		}
+	}
+	Ensemble_iterateur it;
+	i = 0;
+	for(
+		it = premier_iterateur_ensemble( get_initiaux( automate ) );
+		! iterateur_ensemble_est_vide( it );
+		it = iterateur_suivant_ensemble( it )
+	){
+		initiaux[i++] = numero_etat( adj, get_element( it ) );
+	}
+	i = 0;
+	for(
+		it = premier_iterateur_ensemble( get_alphabet( automate ) );
+		! iterateur_ensemble_est_vide( it );
+		it = iterateur_suivant_ensemble( it )
+	){
+		alphabet[i++] = (char) get_element( it );
+	}
+
+	res->nb_etats = n;
+	res->nb_transitions = m;
+	res->nb_initiaux = nb_initiaux;
+	res->taille_alphabet = taille_alphabet;
+	res->etats = etats;
+	res->debut = debut;
+	res->lettres = lettres;
+	res->voisins = voisins;
+	res->initiaux = initiaux;
+	res->finaux = finaux;
+	res->alphabet = alphabet;
+	return res;
+}
+
+void liberer_automate_fige( Automate_fige* automate ){
+	xfree( automate );
+}
+
+int numero_etat_fige( const Automate_fige* automate, int etat ){
+	const int* trouve = bsearch( 
+		&etat, automate->etats, automate->nb_etats, sizeof(int), comparer_int 
+	);
+	return trouve ? trouve - automate->etats : -1;
+}
+
+Ensemble * delta_fige( 
+	const Automate_fige* automate, const Ensemble * etats_courants, char lettre
+){
+	Ensemble * res = creer_ensemble( NULL, NULL, NULL );
+	Ensemble_iterateur it;
+	for( 
+		it = premier_iterateur_ensemble( etats_courants );
+		! iterateur_ensemble_est_vide( it );
+		it = iterateur_suivant_ensemble( it )
+	){
+		int q = numero_etat_fige( automate, get_element( it ) );
+		if( q < 0 ) continue;
+		int j;
+		for( j = automate->debut[q]; j < automate->debut[q+1]; j++ ){
+			if( automate->lettres[j] == lettre ){
+				ajouter_element( res, automate->etats[ automate->voisins[j] ] );
+			}
+		}
+	}
+	return res;
+}
+
+/*
+ * Les états courants sont rangés à la fois dans une liste, pour les 
+ * parcourir, et dans un tableau de bits, pour ne pas les ajouter deux 
+ * fois. Toute la mémoire utilisée est locale à l'appel.
+ */
+int le_mot_est_reconnu_fige( const Automate_fige* automate, const char* mot ){
+	int n = automate->nb_etats;
+	size_t nb_mots = ( n + 63 ) / 64;
+	int* listes = xmalloc( ( 2 * (size_t) n + 1 ) * sizeof(int) );
+	int* courants = listes;
+	int* suivants = listes + n;
+	uint64_t* vus = xmalloc( nb_mots * sizeof(uint64_t) + 1 );
+	memset( vus, 0, nb_mots * sizeof(uint64_t) );
+	int nb_courants = 0, i, j;
+	for( i = 0; i < automate->nb_initiaux; i++ ){
+		int q = automate->initiaux[i];
+		if( ! ( ( vus[ q / 64 ] >> ( q % 64 ) ) & 1 ) ){
+			vus[ q / 64 ] |= (uint64_t) 1 << ( q % 64 );
+			courants[nb_courants++] = q;
+		}
+	}
+
+	for( ; *mot && nb_courants; mot++ ){
+		for( i = 0; i < nb_courants; i++ ){
+			vus[ courants[i] / 64 ] = 0;
+		}
+		int nb_suivants = 0;
+		for( i = 0; i < nb_courants; i++ ){
+			int q = courants[i];
+			for( j = automate->debut[q]; j < automate->debut[q+1]; j++ ){
+				int fin = automate->voisins[j];
+				if( 
+					automate->lettres[j] == *mot 
+					&& ! ( ( vus[ fin / 64 ] >> ( fin % 64 ) ) & 1 )
+				){
+					vus[ fin / 64 ] |= (uint64_t) 1 << ( fin % 64 );
+					suivants[nb_suivants++] = fin;
+				}
+			}
+		}
+		int* echange = courants;
+		courants = suivants;
+		suivants = echange;
+		nb_courants = nb_suivants;
+	}
+
+	int res = 0;
+	for( i = 0; i < nb_courants && ! res; i++ ){
+		res = est_final_fige( automate, courants[i] );
+	}
+	xfree( listes );
+	xfree( vus );
+	return res;
+}
@@ -0,0 +1,129 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file automate_fige.h */ 
+
+#ifndef __AUTOMATE_FIGE_H__
+#define __AUTOMATE_FIGE_H__
+
+#include <stdint.h>
+
+#include "automate.h"
+
+/**
+ * @brief Le type d'un automate figé.
+ *
+ * Un automate figé est une copie en lecture seule d'un automate, rangée 
+ * dans un seul bloc de mémoire. Il n'est jamais modifié après sa 
+ * création : aucune fonction de ce fichier n'écrit dans l'automate figé, 
+ * et aucune n'utilise de cache. Un nombre quelconque de fils d'exécution 
+ * peut donc appeler delta_fige(), le_mot_est_reconnu_fige() et parcourir 
+ * ses champs en même temps, sans verrou.
+ *
+ * Un Automate peut aussi être lu par plusieurs fils en même temps (voir 
+ * automate.h), mais ses fonctions de lecture parcourent des tables et des 
+ * ensembles, et peuvent construire des index à la première demande (voir 
+ * adjacence_automate()).
+ *
+ * Les états sont numérotés comme dans adjacence_automate() : etats[i] est
+ * l'état de numéro i, et ses transitions sont celles d'indices debut[i] à 
+ * debut[i+1]-1, triées par lettre : la j-ième lit lettres[j] et mène à 
+ * l'état de numéro voisins[j]. Les numéros des états initiaux sont dans 
+ * initiaux, et l'état de numéro i est final si le bit i de finaux vaut 1.
+ */
+typedef struct Automate_fige {
+	int nb_etats;
+	int nb_transitions;
+	int nb_initiaux;
+	int taille_alphabet;
+	const int* etats;
+	const int* debut;
+	const char* lettres;
+	const int* voisins;
+	const int* initiaux;
+	const uint64_t* finaux;
+	/** Les lettres de l'alphabet, dans l'ordre de get_alphabet(). */
+	const char* alphabet;
+} Automate_fige;
+
+/**
+ * @brief Fige un automate.
+ *
+ * L'automate ne doit pas être utilisé par d'autres fils d'exécution 
+ * pendant l'appel. Il peut ensuite être modifié ou libéré : l'automate 
+ * figé n'en dépend pas.
+ *
+ * @param automate Un automate.
+ * @return L'automate figé, à libérer avec liberer_automate_fige().
+ */
+Automate_fige* figer_automate( const Automate* automate );
+
+/**
+ * @brief Libère la mémoire d'un automate figé.
+ *
+ * @param automate L'automate figé à libérer.
+ */
+void liberer_automate_fige( Automate_fige* automate );
+
+/**
+ * @brief Renvoie le numéro d'un état dans un automate figé, ou -1 s'il n'en
+ *        est pas un état.
+ *
+ * @param automate Un automate figé.
+ * @param etat Un état.
+ * @return Le numéro de l'état, ou -1.
+ */
+int numero_etat_fige( const Automate_fige* automate, int etat );
+
+/**
+ * @brief Renvoie 1 si l'état de numéro i est final et 0 sinon.
+ *
+ * @param automate Un automate figé.
+ * @param i Un numéro d'état.
+ * @return 1 ou 0.
+ */
+static inline int est_final_fige( const Automate_fige* automate, int i ){
+	return ( automate->finaux[ i / 64 ] >> ( i % 64 ) ) & 1;
+}
+
+/**
+ * @brief Renvoie l'ensemble des états atteints depuis un ensemble d'états
+ *        en lisant une lettre, comme delta().
+ *
+ * @param automate Un automate figé.
+ * @param etats_courants Un ensemble d'états (et non de numéros).
+ * @param lettre La lettre lue.
+ * @return Un nouvel ensemble d'états, à libérer avec liberer_ensemble().
+ */
+Ensemble * delta_fige( 
+	const Automate_fige* automate, const Ensemble * etats_courants, char lettre
+);
+
+/**
+ * @brief Renvoie 1 si le mot est reconnu par l'automate figé et 0 sinon, 
+ *        comme le_mot_est_reconnu().
+ *
+ * @param automate Un automate figé.
+ * @param mot Le mot à reconnaître.
+ * @return 1 ou 0.
+ */
+int le_mot_est_reconnu_fige( const Automate_fige* automate, const char* mot );
+
+#endif
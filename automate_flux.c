@@ -0,0 +1,72 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "automate_flux.h"
+#include "outils.h"
+
+Automate_flux* creer_automate_flux( const Automate* automate ){
+	Automate_flux* flux = xmalloc( sizeof(Automate_flux) );
+	Automate_compile* compile = compiler_automate( automate );
+	initialiser_flux( flux, compile );
+	flux->automate_possede = compile;
+	return flux;
+}
+
+void liberer_automate_flux( Automate_flux* flux ){
+	if( flux ){
+		liberer_automate_compile( flux->automate_possede );
+		xfree( flux );
+	}
+}
+
+void initialiser_flux( Automate_flux* flux, const Automate_compile* automate ){
+	flux->automate = automate;
+	flux->automate_possede = NULL;
+	reinitialiser_flux( flux );
+}
+
+void reinitialiser_flux( Automate_flux* flux ){
+	flux->etat = flux->automate->initial;
+	flux->position = 0;
+}
+
+void lire_flux( Automate_flux* flux, const char* morceau, size_t longueur ){
+	const Automate_compile* automate = flux->automate;
+	const int* transitions = automate->transitions;
+	const uint16_t* classes = automate->classes;
+	const unsigned char* octets = (const unsigned char*) morceau;
+	int nb_classes = automate->nb_classes;
+	int puits = automate->puits;
+	int etat = flux->etat;
+	size_t i;
+	flux->position += longueur;
+	for( i = 0; i < longueur && etat != puits; i++ ){
+		etat = transitions[ etat * nb_classes + classes[ octets[i] ] ];
+	}
+	flux->etat = etat;
+}
+
+int flux_accepte( const Automate_flux* flux ){
+	return est_final_compile( flux->automate, flux->etat );
+}
+
+int flux_est_mort( const Automate_flux* flux ){
+	return flux->etat == flux->automate->puits;
+}
@@ -0,0 +1,114 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file automate_flux.h */ 
+
+#ifndef __AUTOMATE_FLUX_H__
+#define __AUTOMATE_FLUX_H__
+
+#include <stddef.h>
+
+#include "automate.h"
+#include "automate_compile.h"
+
+/**
+ * @brief Le type d'une lecture par morceaux d'un mot.
+ *
+ * Un flux mémorise l'état atteint dans un automate compilé après la 
+ * lecture des octets déjà reçus. Le mot peut donc être donné en autant 
+ * de morceaux que l'on veut, et contenir des octets nuls.
+ *
+ * Un même automate compilé peut être partagé par plusieurs flux : un flux
+ * initialisé avec initialiser_flux() ne possède pas son automate et 
+ * n'alloue aucune mémoire.
+ *
+ * Le champ 'position' compte les octets reçus depuis le début du mot.
+ */
+struct Automate_flux {
+	const Automate_compile* automate;
+	Automate_compile* automate_possede;
+	int etat;
+	size_t position;
+};
+
+typedef struct Automate_flux Automate_flux;
+
+/**
+ * @brief Crée un flux sur un automate, qui est compilé pour l'occasion.
+ *
+ * @param automate Un automate.
+ * @return Le flux, à libérer avec liberer_automate_flux().
+ */
+Automate_flux* creer_automate_flux( const Automate* automate );
+
+/**
+ * @brief Libère un flux créé par creer_automate_flux().
+ *
+ * @param flux Le flux.
+ */
+void liberer_automate_flux( Automate_flux* flux );
+
+/**
+ * @brief Initialise un flux sur un automate compilé, qui n'est pas copié
+ *        et doit rester valide tant que le flux est utilisé.
+ *
+ * @param flux Le flux, par exemple alloué sur la pile.
+ * @param automate Un automate compilé.
+ */
+void initialiser_flux( Automate_flux* flux, const Automate_compile* automate );
+
+/**
+ * @brief Remet un flux au début d'un nouveau mot.
+ *
+ * @param flux Le flux.
+ */
+void reinitialiser_flux( Automate_flux* flux );
+
+/**
+ * @brief Lit un morceau du mot.
+ *
+ * Aucune allocation n'est faite. Si le flux est mort, le morceau est 
+ * ignoré.
+ *
+ * @param flux Le flux.
+ * @param morceau Les octets à lire.
+ * @param longueur Le nombre d'octets à lire.
+ */
+void lire_flux( Automate_flux* flux, const char* morceau, size_t longueur );
+
+/**
+ * @brief Renvoie 1 si les octets lus jusqu'ici forment un mot reconnu et 
+ *        0 sinon.
+ *
+ * @param flux Le flux.
+ * @return 1 ou 0.
+ */
+int flux_accepte( const Automate_flux* flux );
+
+/**
+ * @brief Renvoie 1 si aucune suite du mot ne peut plus être reconnue et 
+ *        0 sinon.
+ *
+ * @param flux Le flux.
+ * @return 1 ou 0.
+ */
+int flux_est_mort( const Automate_flux* flux );
+
+#endif
@@ -0,0 +1,173 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "automate_lot.h"
+#include "outils.h"
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <string.h>
+#include <unistd.h>
+
+typedef struct Lot {
+	const Automate_compile* automate;
+	const Mot* mots;
+	size_t nb_mots;
+	uint64_t* resultats;
+	atomic_size_t prochaine_tranche;
+} Lot;
+
+/*
+ * Reconnaît les mots [debut, fin[ en avançant 'nb_flux' mots à la fois, et
+ * met à 1 les bits des mots reconnus. Les mots actifs sont rangés aux 
+ * places 0 à nb_actifs-1. À chaque tour, tous avancent du nombre d'octets
+ * qui reste au plus court d'entre eux ; le puits étant absorbant, on ne 
+ * vérifie qu'à la fin du tour s'il a été atteint.
+ */
+static void reconnaitre_entrelace(
+	const Automate_compile* automate, const Mot* mots, size_t debut, size_t fin,
+	uint64_t* resultats, int nb_flux
+){
+	const int* transitions = automate->transitions;
+	const uint16_t* classes = automate->classes;
+	int nb_classes = automate->nb_classes;
+	const unsigned char* octets[AUTOMATE_LOT_MAX_FLUX];
+	size_t reste[AUTOMATE_LOT_MAX_FLUX];
+	size_t numeros[AUTOMATE_LOT_MAX_FLUX];
+	int etats[AUTOMATE_LOT_MAX_FLUX];
+	int nb_actifs = 0, f;
+	size_t prochain = debut, i;
+
+	for(;;){
+		while( nb_actifs < nb_flux && prochain < fin ){
+			octets[nb_actifs] = (const unsigned char*) mots[prochain].octets;
+			reste[nb_actifs] = mots[prochain].longueur;
+			numeros[nb_actifs] = prochain++;
+			etats[nb_actifs] = automate->initial;
+			nb_actifs++;
+		}
+		if( ! nb_actifs ) break;
+
+		size_t pas = reste[0];
+		for( f = 1; f < nb_actifs; f++ ){
+			if( reste[f] < pas ) pas = reste[f];
+		}
+		for( i = 0; i < pas; i++ ){
+			for( f = 0; f < nb_actifs; f++ ){
+				etats[f] = transitions[ etats[f] * nb_classes + classes[ octets[f][i] ] ];
+			}
+		}
+
+		f = 0;
+		while( f < nb_actifs ){
+			octets[f] += pas;
+			reste[f] -= pas;
+			if( reste[f] && etats[f] != automate->puits ){
+				f++;
+				continue;
+			}
+			if( ! reste[f] && est_final_compile( automate, etats[f] ) ){
+				resultats[ numeros[f] / 64 ] |= (uint64_t) 1 << ( numeros[f] % 64 );
+			}
+			// Le dernier mot actif prend la place de celui qui est terminé : 
+			// il n'a pas encore avancé pendant ce tour.
+			nb_actifs--;
+			if( f < nb_actifs ){
+				octets[f] = octets[nb_actifs];
+				reste[f] = reste[nb_actifs];
+				numeros[f] = numeros[nb_actifs];
+				etats[f] = etats[nb_actifs];
+			}
+		}
+	}
+}
+
+/*
+ * Reconnaît les mots [debut, fin[ du lot, où debut est un multiple de 64 : 
+ * les mots de bits correspondants ne sont écrits que par ce fil.
+ */
+static void reconnaitre_tranche( const Lot* lot, size_t debut, size_t fin ){
+	memset( 
+		lot->resultats + debut / 64, 0, 
+		( ( fin + 63 ) / 64 - debut / 64 ) * sizeof(uint64_t) 
+	);
+	reconnaitre_entrelace( 
+		lot->automate, lot->mots, debut, fin, lot->resultats, AUTOMATE_LOT_NB_FLUX 
+	);
+}
+
+static void* reconnaitre_tranches( void* argument ){
+	Lot* lot = argument;
+	for(;;){
+		size_t tranche = atomic_fetch_add( &lot->prochaine_tranche, 1 );
+		size_t debut = tranche * AUTOMATE_LOT_MOTS_PAR_TRANCHE;
+		if( debut >= lot->nb_mots ) break;
+		size_t fin = debut + AUTOMATE_LOT_MOTS_PAR_TRANCHE;
+		reconnaitre_tranche( lot, debut, fin < lot->nb_mots ? fin : lot->nb_mots );
+	}
+	return NULL;
+}
+
+void reconnaitre_lot_compile(
+	const Automate_compile* automate, const Mot* mots, size_t nb_mots,
+	uint64_t* resultats, int nb_fils
+){
+	if( nb_fils <= 0 ){
+		long nb = sysconf( _SC_NPROCESSORS_ONLN );
+		nb_fils = nb > 0 ? (int) nb : 1;
+	}
+	size_t nb_tranches = 
+		( nb_mots + AUTOMATE_LOT_MOTS_PAR_TRANCHE - 1 ) / AUTOMATE_LOT_MOTS_PAR_TRANCHE;
+	if( (size_t) nb_fils > nb_tranches ) nb_fils = nb_tranches ? (int) nb_tranches : 1;
+
+	Lot lot;
+	lot.automate = automate;
+	lot.mots = mots;
+	lot.nb_mots = nb_mots;
+	lot.resultats = resultats;
+	atomic_init( &lot.prochaine_tranche, 0 );
+
+	// Le fil appelant travaille aussi.
+	pthread_t* fils = xmalloc( nb_fils * sizeof(pthread_t) );
+	int i;
+	for( i = 1; i < nb_fils; i++ ){
+		if( pthread_create( &fils[i], NULL, reconnaitre_tranches, &lot ) ){
+			ERREUR( "Impossible de créer un fil d'exécution" );
+		}
+	}
+	reconnaitre_tranches( &lot );
+	for( i = 1; i < nb_fils; i++ ){
+		pthread_join( fils[i], NULL );
+	}
+	xfree( fils );
+}
+
+void reconnaitre_mots_entrelaces(
+	const Automate_compile* automate, const Mot* mots, size_t nb_mots,
+	uint64_t* resultats, int nb_flux
+){
+	if( nb_flux < 1 || nb_flux > AUTOMATE_LOT_MAX_FLUX ){
+		ERREUR( "Le nombre de flux doit être entre 1 et AUTOMATE_LOT_MAX_FLUX." );
+	}
+	memset( resultats, 0, ( nb_mots + 63 ) / 64 * sizeof(uint64_t) );
+	reconnaitre_entrelace( automate, mots, 0, nb_mots, resultats, nb_flux );
+}
@@ -0,0 +1,108 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file automate_lot.h */ 
+
+#ifndef __AUTOMATE_LOT_H__
+#define __AUTOMATE_LOT_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "automate_compile.h"
+
+/**
+ * Nombre de mots traités d'un seul tenant par un fil d'exécution. C'est 
+ * un multiple de 64 : deux fils n'écrivent jamais dans le même mot du 
+ * tableau de résultats.
+ */
+#define AUTOMATE_LOT_MOTS_PAR_TRANCHE 1024
+
+/**
+ * Nombre maximal de mots avancés ensemble par reconnaitre_mots_entrelaces().
+ */
+#define AUTOMATE_LOT_MAX_FLUX 16
+
+/**
+ * Nombre de mots avancés ensemble par reconnaitre_lot_compile().
+ */
+#define AUTOMATE_LOT_NB_FLUX 8
+
+/**
+ * @brief Un mot donné par un pointeur et une longueur. Il peut contenir 
+ *        des octets nuls.
+ */
+typedef struct Mot {
+	const char* octets;
+	size_t longueur;
+} Mot;
+
+/**
+ * @brief Reconnaît un lot de mots indépendants avec plusieurs fils 
+ *        d'exécution.
+ *
+ * Les mots sont découpés en tranches de AUTOMATE_LOT_MOTS_PAR_TRANCHE mots
+ * consécutifs, que les fils se répartissent au fur et à mesure. Tous les 
+ * fils lisent le même automate compilé, qui n'est pas modifié. Chaque 
+ * tranche est reconnue par reconnaitre_mots_entrelaces(), avec 
+ * AUTOMATE_LOT_NB_FLUX mots à la fois.
+ *
+ * En sortie, le bit i % 64 de resultats[i / 64] vaut 1 si et seulement si
+ * le mot i est reconnu (voir le_mot_est_reconnu_compile()). Le tableau 
+ * 'resultats' doit contenir (nb_mots + 63) / 64 entiers ; les bits qui 
+ * suivent le dernier mot sont mis à 0.
+ *
+ * @param automate Un automate compilé.
+ * @param mots Les mots à reconnaître.
+ * @param nb_mots Le nombre de mots.
+ * @param resultats Reçoit le tableau de bits des résultats.
+ * @param nb_fils Le nombre de fils d'exécution, ou 0 pour utiliser un fil
+ *        par processeur.
+ */
+void reconnaitre_lot_compile(
+	const Automate_compile* automate, const Mot* mots, size_t nb_mots,
+	uint64_t* resultats, int nb_fils
+);
+
+/**
+ * @brief Reconnaît un lot de mots en avançant plusieurs mots à la fois.
+ *
+ * Les 'nb_flux' premiers mots sont lus ensemble, un octet de chacun à 
+ * chaque pas : les chargements dans la table de transitions de mots 
+ * différents ne dépendent pas les uns des autres, et le processeur peut 
+ * les faire en même temps. Dès qu'un mot est terminé, ou qu'il a atteint
+ * le puits, le mot suivant du lot prend sa place.
+ *
+ * Les résultats sont ceux de reconnaitre_lot_compile(), calculés par le 
+ * seul fil appelant.
+ *
+ * @param automate Un automate compilé.
+ * @param mots Les mots à reconnaître.
+ * @param nb_mots Le nombre de mots.
+ * @param resultats Reçoit le tableau de bits des résultats.
+ * @param nb_flux Le nombre de mots avancés ensemble, entre 1 et 
+ *        AUTOMATE_LOT_MAX_FLUX.
+ */
+void reconnaitre_mots_entrelaces(
+	const Automate_compile* automate, const Mot* mots, size_t nb_mots,
+	uint64_t* resultats, int nb_flux
+);
+
+#endif
@@ -0,0 +1,179 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "automate_multiple.h"
+#include "outils.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+	Automate* reunion;
+	int decalage;
+} data_reunir;
+
+static void action_reunir( int origine, char lettre, int fin, void* data ){
+	data_reunir* d = (data_reunir*) data;
+	ajouter_transition( d->reunion, origine + d->decalage, lettre, fin + d->decalage );
+}
+
+Automate_multiple* creer_automate_multiple( Rationnel** motifs, int nb_motifs ){
+	// Réunion disjointe des automates de Glushkov : les états du motif i 
+	// sont décalés de decalages[i], et motif_final[q] est le motif dont q 
+	// est un état final (-1 sinon).
+	Automate* reunion = creer_automate();
+	int* decalages = xmalloc( ( nb_motifs + 1 ) * sizeof(int) );
+	int i, q, c;
+	decalages[0] = 0;
+	for( i = 0; i < nb_motifs; i++ ){
+		Automate* glushkov = Glushkov( motifs[i] );
+		data_reunir data;
+		data.reunion = reunion;
+		data.decalage = decalages[i];
+		pour_toute_transition( glushkov, action_reunir, &data );
+		ajouter_etat_initial( reunion, decalages[i] );
+		Ensemble_iterateur it;
+		for(
+			it = premier_iterateur_ensemble( get_alphabet( glushkov ) );
+			! iterateur_ensemble_est_vide( it );
+			it = iterateur_suivant_ensemble( it )
+		){
+			ajouter_lettre( reunion, get_element( it ) );
+		}
+		for(
+			it = premier_iterateur_ensemble( get_finaux( glushkov ) );
+			! iterateur_ensemble_est_vide( it );
+			it = iterateur_suivant_ensemble( it )
+		){
+			ajouter_etat_final( reunion, get_element( it ) + decalages[i] );
+		}
+		decalages[i+1] = decalages[i] + get_max_etat( glushkov ) + 1;
+		liberer_automate( glushkov );
+	}
+	int* motif_final = xmalloc( ( decalages[nb_motifs] + 1 ) * sizeof(int) );
+	for( q = 0; q < decalages[nb_motifs]; q++ ) motif_final[q] = -1;
+	for( i = 0; i < nb_motifs; i++ ){
+		for( q = decalages[i]; q < decalages[i+1]; q++ ){
+			if( est_un_etat_final_de_l_automate( reunion, q ) ) motif_final[q] = i;
+		}
+	}
+
+	Dictionnaire* sous_ensembles;
+	Automate* det = creer_automate_deterministe_sous_ensembles( 
+		reunion, &sous_ensembles 
+	);
+	int n = taille_dictionnaire( sous_ensembles );
+
+	Automate_multiple* res = xmalloc( sizeof(Automate_multiple) );
+	res->nb_motifs = nb_motifs;
+	res->initial = 0;
+	// Les lettres qui mènent toujours aux mêmes états partagent une classe.
+	char lettres[257];
+	res->nb_classes = classes_de_lettres( det, res->classes, lettres );
+	res->nb_etats = n + 1;
+
+	// Le puits est l'ensemble vide s'il a été atteint, et un état 
+	// supplémentaire sinon.
+	Ensemble* vide = creer_ensemble( NULL, NULL, NULL );
+	res->puits = chercher_dictionnaire( sous_ensembles, vide );
+	if( res->puits < 0 ) res->puits = n;
+	liberer_ensemble( vide );
+
+	Ensemble_iterateur it;
+
+	res->transitions = xmalloc( (size_t) res->nb_etats * res->nb_classes * sizeof(int) );
+	for( q = 0; q < res->nb_etats * res->nb_classes; q++ ){
+		res->transitions[q] = res->puits;
+	}
+	for( q = 0; q < n; q++ ){
+		for( c = 1; c < res->nb_classes; c++ ){
+			const Ensemble* fins = voisins( det, q, lettres[c] );
+			res->transitions[ q * res->nb_classes + c ] = 
+				get_element( premier_iterateur_ensemble( fins ) );
+		}
+	}
+
+	// Motifs reconnus dans chaque état, au format CSR.
+	Ensemble** motifs_etat = xmalloc( ( n + 1 ) * sizeof(Ensemble*) );
+	res->debut_motifs = xmalloc( ( res->nb_etats + 1 ) * sizeof(int) );
+	res->debut_motifs[0] = 0;
+	for( q = 0; q < n; q++ ){
+		motifs_etat[q] = creer_ensemble( NULL, NULL, NULL );
+		for(
+			it = premier_iterateur_ensemble( ensemble_de_identifiant( sous_ensembles, q ) );
+			! iterateur_ensemble_est_vide( it );
+			it = iterateur_suivant_ensemble( it )
+		){
+			if( motif_final[ get_element( it ) ] >= 0 ){
+				ajouter_element( motifs_etat[q], motif_final[ get_element( it ) ] );
+			}
+		}
+		res->debut_motifs[q+1] = 
+			res->debut_motifs[q] + taille_ensemble( motifs_etat[q] );
+	}
+	res->debut_motifs[n+1] = res->debut_motifs[n];
+	res->motifs = xmalloc( ( res->debut_motifs[n] + 1 ) * sizeof(int) );
+	for( q = 0; q < n; q++ ){
+		int j = res->debut_motifs[q];
+		for(
+			it = premier_iterateur_ensemble( motifs_etat[q] );
+			! iterateur_ensemble_est_vide( it );
+			it = iterateur_suivant_ensemble( it )
+		){
+			res->motifs[j++] = get_element( it );
+		}
+		liberer_ensemble( motifs_etat[q] );
+	}
+
+	xfree( motifs_etat );
+	liberer_dictionnaire( sous_ensembles );
+	liberer_automate( det );
+	xfree( motif_final );
+	xfree( decalages );
+	liberer_automate( reunion );
+	return res;
+}
+
+void liberer_automate_multiple( Automate_multiple* automate ){
+	if( automate ){
+		xfree( automate->transitions );
+		xfree( automate->debut_motifs );
+		xfree( automate->motifs );
+		xfree( automate );
+	}
+}
+
+int motifs_reconnus(
+	const Automate_multiple* automate, const char* mot, size_t longueur,
+	const int** motifs
+){
+	const int* transitions = automate->transitions;
+	const uint16_t* classes = automate->classes;
+	const unsigned char* octets = (const unsigned char*) mot;
+	int nb_classes = automate->nb_classes;
+	int puits = automate->puits;
+	int etat = automate->initial;
+	size_t i;
+	for( i = 0; i < longueur && etat != puits; i++ ){
+		etat = transitions[ etat * nb_classes + classes[ octets[i] ] ];
+	}
+	*motifs = automate->motifs + automate->debut_motifs[etat];
+	return automate->debut_motifs[ etat + 1 ] - automate->debut_motifs[etat];
+}
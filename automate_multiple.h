@@ -0,0 +1,96 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file automate_multiple.h */ 
+
+#ifndef __AUTOMATE_MULTIPLE_H__
+#define __AUTOMATE_MULTIPLE_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "automate.h"
+#include "rationnel.h"
+
+/**
+ * @brief Le type d'un automate qui reconnaît plusieurs motifs à la fois.
+ *
+ * Les automates de Glushkov des motifs sont réunis en un seul automate, 
+ * qui est déterminisé. Chaque état q du déterminisé est un ensemble 
+ * d'états des automates des motifs : les motifs reconnus en q sont ceux 
+ * dont un état final est dans cet ensemble. Leurs numéros, triés, sont 
+ * motifs[ debut_motifs[q] ] à motifs[ debut_motifs[q+1] - 1 ].
+ *
+ * Comme pour un automate compilé, l'état atteint depuis q en lisant un 
+ * octet de classe c est transitions[ q*nb_classes + c ], et la classe 0 
+ * (octets hors de l'alphabet) mène dans le puits, d'où aucun motif ne 
+ * peut plus être reconnu.
+ */
+struct Automate_multiple {
+	int nb_motifs;
+	int nb_etats;
+	int nb_classes;
+	int initial;
+	int puits;
+	uint16_t classes[256];
+	int* transitions;
+	int* debut_motifs;
+	int* motifs;
+};
+
+typedef struct Automate_multiple Automate_multiple;
+
+/**
+ * @brief Crée l'automate qui reconnaît plusieurs motifs.
+ *
+ * Le motif i est l'expression motifs[i]. Les expressions sont numérotées
+ * (voir numeroter_rationnel()) mais ne sont pas libérées.
+ *
+ * @param motifs Les expressions des motifs.
+ * @param nb_motifs Le nombre de motifs.
+ * @return L'automate, à libérer avec liberer_automate_multiple().
+ */
+Automate_multiple* creer_automate_multiple( Rationnel** motifs, int nb_motifs );
+
+/**
+ * @brief Libère la mémoire d'un automate à plusieurs motifs.
+ *
+ * @param automate L'automate à libérer.
+ */
+void liberer_automate_multiple( Automate_multiple* automate );
+
+/**
+ * @brief Lit un mot et renvoie les motifs qui le reconnaissent.
+ *
+ * Le mot n'est lu qu'une fois et aucune allocation n'est faite.
+ *
+ * @param automate Un automate à plusieurs motifs.
+ * @param mot Le mot à lire.
+ * @param longueur La longueur du mot, en octets.
+ * @param motifs Reçoit un pointeur vers les numéros, triés, des motifs 
+ *        qui reconnaissent le mot. Ce tableau appartient à l'automate.
+ * @return Le nombre de motifs qui reconnaissent le mot.
+ */
+int motifs_reconnus(
+	const Automate_multiple* automate, const char* mot, size_t longueur,
+	const int** motifs
+);
+
+#endif
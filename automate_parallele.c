@@ -0,0 +1,435 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "automate_parallele.h"
+#include "outils.h"
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define NB_TRANCHES 64
+
+/*
+ * Un sous-ensemble d'états de l'automate d'origine, donnés par leurs 
+ * numéros dans l'index des transitions, dans l'ordre croissant.
+ * cibles[c-1] est son image par la classe de lettres c ; elle n'est
+ * écrite que par le fil qui traite le sous-ensemble.
+ */
+typedef struct Sous_ensemble {
+	int taille;
+	int* etats;
+	uint64_t hachage;
+	struct Sous_ensemble** cibles;
+	int numero;
+} Sous_ensemble;
+
+/*
+ * Une tranche de la table des sous-ensembles : une table de hachage à 
+ * adressage ouvert, protégée par son propre verrou.
+ */
+typedef struct Tranche {
+	pthread_mutex_t verrou;
+	Sous_ensemble** alveoles;
+	int taille;
+	int nb;
+} Tranche;
+
+/*
+ * La file de travail d'un fil. Il y ajoute et y reprend les 
+ * sous-ensembles par la fin ; les autres fils y volent par le début.
+ */
+typedef struct File_travail {
+	pthread_mutex_t verrou;
+	Sous_ensemble** elements;
+	int capacite;
+	int debut;
+	int fin;
+} File_travail;
+
+typedef struct Determinisation {
+	const Adjacence* adjacence;
+	uint16_t classes[256];
+	char representants[257];
+	int nb_classes;
+	Tranche tranches[NB_TRANCHES];
+	File_travail* files;
+	int nb_fils;
+	/* Nombre de sous-ensembles créés qui n'ont pas encore été traités. */
+	atomic_int en_attente;
+} Determinisation;
+
+typedef struct Fil {
+	Determinisation* determinisation;
+	int numero;
+	pthread_t id;
+	/* Marques des états déjà vus dans l'image en cours de calcul. */
+	unsigned int* marques;
+	unsigned int marque;
+	int* debut_classe;
+	int* images;
+	int taille_images;
+} Fil;
+
+static int comparer_int( const void* a, const void* b ){
+	int x = *(const int*) a;
+	int y = *(const int*) b;
+	return ( x > y ) - ( x < y );
+}
+
+static uint64_t hacher_etats( const int* etats, int taille ){
+	uint64_t h = 0xcbf29ce484222325ULL;
+	int i;
+	for( i = 0; i < taille; i++ ){
+		h = ( h ^ (uint32_t) etats[i] ) * 0x100000001b3ULL;
+	}
+	return h ^ ( h >> 29 );
+}
+
+static void agrandir_tranche( Tranche* tranche ){
+	int taille = 2 * tranche->taille;
+	Sous_ensemble** alveoles = xmalloc( taille * sizeof(Sous_ensemble*) );
+	memset( alveoles, 0, taille * sizeof(Sous_ensemble*) );
+	int i;
+	for( i = 0; i < tranche->taille; i++ ){
+		Sous_ensemble* s = tranche->alveoles[i];
+		if( ! s ) continue;
+		size_t h = ( s->hachage / NB_TRANCHES ) & ( taille - 1 );
+		while( alveoles[h] ) h = ( h + 1 ) & ( taille - 1 );
+		alveoles[h] = s;
+	}
+	xfree( tranche->alveoles );
+	tranche->alveoles = alveoles;
+	tranche->taille = taille;
+}
+
+/*
+ * Renvoie le sous-ensemble égal à etats[0..taille[, en le créant s'il 
+ * n'existe pas encore ; 'nouveau' est alors mis à 1.
+ */
+static Sous_ensemble* interner_sous_ensemble( 
+	Determinisation* d, const int* etats, int taille, int* nouveau
+){
+	uint64_t hachage = hacher_etats( etats, taille );
+	Tranche* tranche = &d->tranches[ hachage % NB_TRANCHES ];
+	pthread_mutex_lock( &tranche->verrou );
+	size_t h = ( hachage / NB_TRANCHES ) & ( tranche->taille - 1 );
+	Sous_ensemble* s;
+	while( ( s = tranche->alveoles[h] ) ){
+		if( 
+			s->hachage == hachage && s->taille == taille
+			&& memcmp( s->etats, etats, taille * sizeof(int) ) == 0
+		){
+			pthread_mutex_unlock( &tranche->verrou );
+			*nouveau = 0;
+			return s;
+		}
+		h = ( h + 1 ) & ( tranche->taille - 1 );
+	}
+	s = xmalloc( sizeof(Sous_ensemble) );
+	s->taille = taille;
+	s->etats = xmalloc( taille * sizeof(int) + 1 );
+	memcpy( s->etats, etats, taille * sizeof(int) );
+	s->hachage = hachage;
+	s->cibles = xmalloc( d->nb_classes * sizeof(Sous_ensemble*) + 1 );
+	s->numero = -1;
+	tranche->alveoles[h] = s;
+	tranche->nb++;
+	if( 2 * tranche->nb > tranche->taille ){
+		agrandir_tranche( tranche );
+	}
+	pthread_mutex_unlock( &tranche->verrou );
+	*nouveau = 1;
+	return s;
+}
+
+static void empiler_travail( File_travail* file, Sous_ensemble* s ){
+	pthread_mutex_lock( &file->verrou );
+	if( file->fin == file->capacite ){
+		if( file->debut > file->capacite / 2 ){
+			memmove( 
+				file->elements, file->elements + file->debut, 
+				( file->fin - file->debut ) * sizeof(Sous_ensemble*) 
+			);
+			file->fin -= file->debut;
+			file->debut = 0;
+		}else{
+			file->capacite *= 2;
+			file->elements = xrealloc( 
+				file->elements, file->capacite * sizeof(Sous_ensemble*) 
+			);
+		}
+	}
+	file->elements[ file->fin++ ] = s;
+	pthread_mutex_unlock( &file->verrou );
+}
+
+/*
+ * Prend un sous-ensemble à la fin de la file si 'voler' vaut 0, au début 
+ * sinon. Renvoie NULL si la file est vide.
+ */
+static Sous_ensemble* prendre_travail( File_travail* file, int voler ){
+	Sous_ensemble* s = NULL;
+	pthread_mutex_lock( &file->verrou );
+	if( file->debut < file->fin ){
+		s = voler ? file->elements[ file->debut++ ] : file->elements[ --file->fin ];
+	}
+	pthread_mutex_unlock( &file->verrou );
+	return s;
+}
+
+/*
+ * Calcule les images d'un sous-ensemble par chaque classe de lettres. 
+ * Les transitions de ses états sont d'abord réparties par classe, en ne 
+ * gardant que celles du représentant de chaque classe.
+ */
+static void traiter_sous_ensemble( Fil* fil, Sous_ensemble* s ){
+	Determinisation* d = fil->determinisation;
+	const Adjacence* adj = d->adjacence;
+	int i, j, c;
+
+	memset( fil->debut_classe, 0, ( d->nb_classes + 2 ) * sizeof(int) );
+	for( i = 0; i < s->taille; i++ ){
+		int q = s->etats[i];
+		for( j = adj->debut[q]; j < adj->debut[q+1]; j++ ){
+			char lettre = adj->lettres[j];
+			c = d->classes[ (unsigned char) lettre ];
+			if( d->representants[c] == lettre ) fil->debut_classe[c+1]++;
+		}
+	}
+	for( c = 1; c <= d->nb_classes; c++ ){
+		fil->debut_classe[c+1] += fil->debut_classe[c];
+	}
+	int total = fil->debut_classe[ d->nb_classes + 1 ];
+	if( total > fil->taille_images ){
+		fil->taille_images = 2 * total;
+		xfree( fil->images );
+		fil->images = xmalloc( fil->taille_images * sizeof(int) );
+	}
+	int* remplissage = fil->debut_classe + 1;
+	for( i = 0; i < s->taille; i++ ){
+		int q = s->etats[i];
+		for( j = adj->debut[q]; j < adj->debut[q+1]; j++ ){
+			char lettre = adj->lettres[j];
+			c = d->classes[ (unsigned char) lettre ];
+			if( d->representants[c] == lettre ){
+				fil->images[ remplissage[c-1]++ ] = adj->voisins[j];
+			}
+		}
+	}
+	// Après le remplissage, debut_classe[c] est la fin de la classe c.
+
+	int debut = 0;
+	for( c = 1; c <= d->nb_classes; c++ ){
+		int fin = fil->debut_classe[c];
+		int* image = fil->images + debut;
+		int taille = 0;
+		if( ++fil->marque == 0 ){
+			memset( fil->marques, 0, adj->nb_etats * sizeof(unsigned int) );
+			fil->marque = 1;
+		}
+		for( i = debut; i < fin; i++ ){
+			int q = fil->images[i];
+			if( fil->marques[q] != fil->marque ){
+				fil->marques[q] = fil->marque;
+				image[taille++] = q;
+			}
+		}
+		qsort( image, taille, sizeof(int), comparer_int );
+
+		int nouveau;
+		Sous_ensemble* cible = interner_sous_ensemble( d, image, taille, &nouveau );
+		s->cibles[c-1] = cible;
+		if( nouveau ){
+			atomic_fetch_add( &d->en_attente, 1 );
+			empiler_travail( &d->files[ fil->numero ], cible );
+		}
+		debut = fin;
+	}
+	atomic_fetch_sub( &d->en_attente, 1 );
+}
+
+static void* travailler( void* argument ){
+	Fil* fil = argument;
+	Determinisation* d = fil->determinisation;
+	while( atomic_load( &d->en_attente ) > 0 ){
+		Sous_ensemble* s = prendre_travail( &d->files[ fil->numero ], 0 );
+		int i;
+		for( i = 1; ! s && i < d->nb_fils; i++ ){
+			s = prendre_travail( &d->files[ ( fil->numero + i ) % d->nb_fils ], 1 );
+		}
+		if( s ){
+			traiter_sous_ensemble( fil, s );
+		}else{
+			sched_yield();
+		}
+	}
+	return NULL;
+}
+
+Automate * creer_automate_deterministe_parallele( 
+	const Automate* automate, int nb_fils 
+){
+	if( nb_fils <= 0 ){
+		long nb = sysconf( _SC_NPROCESSORS_ONLN );
+		nb_fils = nb > 0 ? (int) nb : 1;
+	}
+	int i, c;
+
+	// L'index et les classes sont construits avant le lancement des fils,
+	// qui ne font ensuite que les lire.
+	Determinisation* d = xmalloc( sizeof(Determinisation) );
+	d->adjacence = adjacence_automate( automate );
+	d->nb_classes = classes_de_lettres( 
+		automate, d->classes, d->representants 
+	) - 1;
+	d->nb_fils = nb_fils;
+	for( i = 0; i < NB_TRANCHES; i++ ){
+		pthread_mutex_init( &d->tranches[i].verrou, NULL );
+		d->tranches[i].taille = 16;
+		d->tranches[i].nb = 0;
+		d->tranches[i].alveoles = xmalloc( 16 * sizeof(Sous_ensemble*) );
+		memset( d->tranches[i].alveoles, 0, 16 * sizeof(Sous_ensemble*) );
+	}
+	d->files = xmalloc( nb_fils * sizeof(File_travail) );
+	for( i = 0; i < nb_fils; i++ ){
+		pthread_mutex_init( &d->files[i].verrou, NULL );
+		d->files[i].capacite = 64;
+		d->files[i].elements = xmalloc( 64 * sizeof(Sous_ensemble*) );
+		d->files[i].debut = 0;
+		d->files[i].fin = 0;
+	}
+
+	const Adjacence* adj = d->adjacence;
+	int* initiaux = xmalloc( 
+		( taille_ensemble( get_initiaux( automate ) ) + 1 ) * sizeof(int) 
+	);
+	int nb_initiaux = 0;
+	Ensemble_iterateur it;
+	for(
+		it = premier_iterateur_ensemble( get_initiaux( automate ) );
+		! iterateur_ensemble_est_vide( it );
+		it = iterateur_suivant_ensemble( it )
+	){
+		initiaux[nb_initiaux++] = numero_etat( adj, get_element( it ) );
+	}
+	int nouveau;
+	Sous_ensemble* initial = 
+		interner_sous_ensemble( d, initiaux, nb_initiaux, &nouveau );
+	xfree( initiaux );
+	atomic_init( &d->en_attente, 1 );
+	empiler_travail( &d->files[0], initial );
+
+	// Le fil appelant travaille aussi, sous le numéro 0.
+	Fil* fils = xmalloc( nb_fils * sizeof(Fil) );
+	for( i = 0; i < nb_fils; i++ ){
+		fils[i].determinisation = d;
+		fils[i].numero = i;
+		fils[i].marques = xmalloc( adj->nb_etats * sizeof(unsigned int) + 1 );
+		memset( fils[i].marques, 0, adj->nb_etats * sizeof(unsigned int) );
+		fils[i].marque = 0;
+		fils[i].debut_classe = xmalloc( ( d->nb_classes + 2 ) * sizeof(int) );
+		fils[i].taille_images = 64;
+		fils[i].images = xmalloc( 64 * sizeof(int) );
+	}
+	for( i = 1; i < nb_fils; i++ ){
+		if( pthread_create( &fils[i].id, NULL, travailler, &fils[i] ) ){
+			ERREUR( "Impossible de créer un fil d'exécution" );
+		}
+	}
+	travailler( &fils[0] );
+	for( i = 1; i < nb_fils; i++ ){
+		pthread_join( fils[i].id, NULL );
+	}
+
+	// Renumérotation canonique : parcours en largeur depuis le 
+	// sous-ensemble initial, classe par classe, comme le fait 
+	// creer_automate_deterministe().
+	int nb_sous_ensembles = 0;
+	for( i = 0; i < NB_TRANCHES; i++ ){
+		nb_sous_ensembles += d->tranches[i].nb;
+	}
+	Sous_ensemble** ordre = xmalloc( nb_sous_ensembles * sizeof(Sous_ensemble*) );
+	int nb_ordre = 0;
+	initial->numero = nb_ordre;
+	ordre[nb_ordre++] = initial;
+	for( i = 0; i < nb_ordre; i++ ){
+		for( c = 0; c < d->nb_classes; c++ ){
+			Sous_ensemble* cible = ordre[i]->cibles[c];
+			if( cible->numero < 0 ){
+				cible->numero = nb_ordre;
+				ordre[nb_ordre++] = cible;
+			}
+		}
+	}
+
+	Automate * res = creer_automate();
+	ajouter_etat_initial( res, 0 );
+	for( i = 0; i < nb_ordre; i++ ){
+		Sous_ensemble* s = ordre[i];
+		ajouter_etat( res, i );
+		for(
+			it = premier_iterateur_ensemble( get_alphabet( automate ) );
+			! iterateur_ensemble_est_vide( it );
+			it = iterateur_suivant_ensemble( it )
+		){
+			char lettre = (char) get_element( it );
+			ajouter_transition( 
+				res, i, lettre, 
+				s->cibles[ d->classes[ (unsigned char) lettre ] - 1 ]->numero 
+			);
+		}
+		int j;
+		for( j = 0; j < s->taille; j++ ){
+			if( est_un_etat_final_de_l_automate( automate, adj->etats[ s->etats[j] ] ) ){
+				ajouter_etat_final( res, i );
+				break;
+			}
+		}
+	}
+
+	for( i = 0; i < nb_ordre; i++ ){
+		xfree( ordre[i]->etats );
+		xfree( ordre[i]->cibles );
+		xfree( ordre[i] );
+	}
+	xfree( ordre );
+	for( i = 0; i < nb_fils; i++ ){
+		xfree( fils[i].marques );
+		xfree( fils[i].debut_classe );
+		xfree( fils[i].images );
+		xfree( d->files[i].elements );
+		pthread_mutex_destroy( &d->files[i].verrou );
+	}
+	xfree( fils );
+	for( i = 0; i < NB_TRANCHES; i++ ){
+		xfree( d->tranches[i].alveoles );
+		pthread_mutex_destroy( &d->tranches[i].verrou );
+	}
+	xfree( d->files );
+	xfree( d );
+	return res;
+}
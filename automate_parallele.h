@@ -0,0 +1,53 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file automate_parallele.h */ 
+
+#ifndef __AUTOMATE_PARALLELE_H__
+#define __AUTOMATE_PARALLELE_H__
+
+#include "automate.h"
+
+/**
+ * @brief Déterminise un automate avec plusieurs fils d'exécution.
+ *
+ * Chaque fil traite des sous-ensembles d'états pris dans sa propre file ;
+ * quand elle est vide, il en vole dans celles des autres fils. Les images
+ * d'un sous-ensemble par chaque classe de lettres (voir 
+ * classes_de_lettres()) sont calculées indépendamment et rangées dans une 
+ * table de sous-ensembles partagée, découpée en tranches protégées chacune
+ * par un verrou.
+ *
+ * Les états sont ensuite renumérotés par un parcours en largeur depuis 
+ * l'état initial : le résultat est exactement celui de 
+ * creer_automate_deterministe(), quel que soit le nombre de fils.
+ *
+ * L'automate ne doit pas être modifié pendant la déterminisation.
+ *
+ * @param automate Un automate.
+ * @param nb_fils Le nombre de fils d'exécution, ou 0 pour utiliser un fil
+ *        par processeur.
+ * @return L'automate déterministe, à libérer avec liberer_automate().
+ */
+Automate * creer_automate_deterministe_parallele( 
+	const Automate* automate, int nb_fils 
+);
+
+#endif
@@ -0,0 +1,176 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "automate_paresseux.h"
+#include "outils.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define ETAT_FINAL 1
+#define ETAT_MORT 2
+
+Automate_paresseux* creer_automate_paresseux( 
+	const Automate* automate, int taille_cache 
+){
+	if( taille_cache < 1 ){
+		ERREUR( "La taille du cache doit être au moins 1." );
+	}
+	Automate_paresseux* res = xmalloc( sizeof(Automate_paresseux) );
+	res->automate = automate;
+	res->taille_cache = taille_cache;
+
+	// La classe 0 regroupe les octets hors de l'alphabet ; les lettres
+	// équivalentes partagent une classe, donc une entrée du cache.
+	res->nb_classes = classes_de_lettres( automate, res->classes, res->lettres );
+
+	res->etats = creer_dictionnaire();
+	res->transitions = xmalloc( 
+		(size_t) taille_cache * res->nb_classes * sizeof(int) 
+	);
+	res->statuts = xmalloc( taille_cache );
+	res->initial = -1;
+	res->octets_depuis_vidage = 0;
+	res->nb_succes = 0;
+	res->nb_echecs = 0;
+	res->nb_vidages = 0;
+	res->nb_replis = 0;
+	return res;
+}
+
+void liberer_automate_paresseux( Automate_paresseux* automate ){
+	if( automate ){
+		liberer_dictionnaire( automate->etats );
+		xfree( automate->transitions );
+		xfree( automate->statuts );
+		xfree( automate );
+	}
+}
+
+static int contient_un_etat_final( const Automate* automate, const Ensemble* ens ){
+	Ensemble* finaux = creer_intersection_ensemble( ens, get_finaux( automate ) );
+	int res = taille_ensemble( finaux ) != 0;
+	liberer_ensemble( finaux );
+	return res;
+}
+
+static void vider_cache( Automate_paresseux* automate ){
+	liberer_dictionnaire( automate->etats );
+	automate->etats = creer_dictionnaire();
+	automate->initial = -1;
+	automate->octets_depuis_vidage = 0;
+	automate->nb_vidages++;
+}
+
+/*
+ * Renvoie le numéro de l'état associé à un ensemble, dont la fonction 
+ * prend possession. L'ensemble doit déjà être dans le cache ou le cache 
+ * ne doit pas être plein.
+ */
+static int ajouter_etat_paresseux( Automate_paresseux* automate, Ensemble* ens ){
+	int nouveau;
+	int mort = taille_ensemble( ens ) == 0;
+	int id = identifiant_ensemble( automate->etats, ens, &nouveau );
+	if( nouveau ){
+		int c;
+		for( c = 0; c < automate->nb_classes; c++ ){
+			automate->transitions[ id * automate->nb_classes + c ] = -1;
+		}
+		const Ensemble* e = ensemble_de_identifiant( automate->etats, id );
+		automate->statuts[id] = 
+			( contient_un_etat_final( automate->automate, e ) ? ETAT_FINAL : 0 ) |
+			( mort ? ETAT_MORT : 0 );
+	}
+	return id;
+}
+
+/*
+ * Lit la fin d'un mot directement sur l'automate non déterministe.
+ */
+static int reconnaitre_sans_cache(
+	const Automate* automate, Ensemble* courant, const char* mot, size_t longueur
+){
+	size_t i;
+	for( i = 0; i < longueur && taille_ensemble( courant ); i++ ){
+		Ensemble* suivant = delta( automate, courant, mot[i] );
+		liberer_ensemble( courant );
+		courant = suivant;
+	}
+	int res = contient_un_etat_final( automate, courant );
+	liberer_ensemble( courant );
+	return res;
+}
+
+int le_mot_est_reconnu_paresseux(
+	Automate_paresseux* automate, const char* mot, size_t longueur
+){
+	const unsigned char* octets = (const unsigned char*) mot;
+	int k = automate->nb_classes;
+	if( automate->initial < 0 ){
+		if( taille_dictionnaire( automate->etats ) >= automate->taille_cache ){
+			vider_cache( automate );
+		}
+		automate->initial = ajouter_etat_paresseux(
+			automate, copier_ensemble( get_initiaux( automate->automate ) )
+		);
+	}
+	int etat = automate->initial;
+	size_t i;
+	for( i = 0; i < longueur; i++ ){
+		if( automate->statuts[etat] & ETAT_MORT ) return 0;
+		int c = automate->classes[ octets[i] ];
+		int suivant = automate->transitions[ etat * k + c ];
+		automate->octets_depuis_vidage++;
+		if( suivant >= 0 ){
+			automate->nb_succes++;
+			etat = suivant;
+			continue;
+		}
+		automate->nb_echecs++;
+		const Ensemble* courant = ensemble_de_identifiant( automate->etats, etat );
+		Ensemble* ens = c ? 
+			delta( automate->automate, courant, automate->lettres[c] ) :
+			creer_ensemble( NULL, NULL, NULL );
+		if(
+			taille_dictionnaire( automate->etats ) >= automate->taille_cache &&
+			chercher_dictionnaire( automate->etats, ens ) < 0
+		){
+			// Le cache est plein : on le vide, sauf s'il a été trop peu 
+			// utilisé depuis le dernier vidage, auquel cas on se passe de 
+			// lui pour la fin du mot.
+			int inefficace = 
+				automate->octets_depuis_vidage < (size_t)
+				AUTOMATE_PARESSEUX_OCTETS_PAR_ETAT * automate->taille_cache;
+			vider_cache( automate );
+			if( inefficace ){
+				automate->nb_replis++;
+				return reconnaitre_sans_cache( 
+					automate->automate, ens, mot + i + 1, longueur - i - 1 
+				);
+			}
+			etat = ajouter_etat_paresseux( automate, ens );
+		}else{
+			suivant = ajouter_etat_paresseux( automate, ens );
+			automate->transitions[ etat * k + c ] = suivant;
+			etat = suivant;
+		}
+	}
+	return automate->statuts[etat] & ETAT_FINAL ? 1 : 0;
+}
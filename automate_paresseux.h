@@ -0,0 +1,119 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file automate_paresseux.h */ 
+
+#ifndef __AUTOMATE_PARESSEUX_H__
+#define __AUTOMATE_PARESSEUX_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "automate.h"
+#include "dictionnaire.h"
+
+/**
+ * @brief Nombre minimal d'octets lus par état créé en dessous duquel le 
+ *        cache est jugé inefficace.
+ *
+ * Si, au moment de vider le cache, on a lu moins de 
+ * AUTOMATE_PARESSEUX_OCTETS_PAR_ETAT octets par état créé depuis le vidage 
+ * précédent, la fin du mot est lue directement sur l'automate non 
+ * déterministe.
+ */
+#define AUTOMATE_PARESSEUX_OCTETS_PAR_ETAT 10
+
+/**
+ * @brief Le type d'un automate déterministe construit à la volée.
+ *
+ * Les états sont des ensembles d'états de l'automate d'origine, créés au 
+ * fur et à mesure de la lecture des mots et numérotés par un dictionnaire.
+ * La transition de l'état q par un octet de classe c est mémorisée dans 
+ * transitions[ q*nb_classes + c ] (-1 si elle n'est pas encore calculée).
+ *
+ * Le cache contient au plus 'taille_cache' états. Quand il est plein, il 
+ * est vidé entièrement avant de créer un nouvel état.
+ *
+ * Les compteurs permettent de dimensionner le cache :
+ * - nb_succes : transitions trouvées dans le cache ;
+ * - nb_echecs : transitions calculées avec delta() ;
+ * - nb_vidages : nombre de fois où le cache a été vidé ;
+ * - nb_replis : nombre de mots terminés sans le cache, par l'automate non 
+ *   déterministe.
+ *
+ * L'automate d'origine ne doit pas être modifié tant que l'automate 
+ * paresseux est utilisé.
+ */
+struct Automate_paresseux {
+	const Automate* automate;
+	int taille_cache;
+	int nb_classes;
+	uint16_t classes[256];
+	char lettres[257];
+	Dictionnaire* etats;
+	int* transitions;
+	unsigned char* statuts;
+	int initial;
+	size_t octets_depuis_vidage;
+	long nb_succes;
+	long nb_echecs;
+	long nb_vidages;
+	long nb_replis;
+};
+
+typedef struct Automate_paresseux Automate_paresseux;
+
+/**
+ * @brief Crée un automate déterministe paresseux.
+ *
+ * Aucun état n'est calculé à la création.
+ *
+ * @param automate L'automate, éventuellement non déterministe, à simuler.
+ * @param taille_cache Le nombre maximal d'états mémorisés (au moins 1).
+ * @return L'automate paresseux, à libérer avec liberer_automate_paresseux().
+ */
+Automate_paresseux* creer_automate_paresseux( 
+	const Automate* automate, int taille_cache 
+);
+
+/**
+ * @brief Libère la mémoire d'un automate paresseux.
+ *
+ * L'automate d'origine n'est pas libéré.
+ *
+ * @param automate L'automate paresseux à libérer.
+ */
+void liberer_automate_paresseux( Automate_paresseux* automate );
+
+/**
+ * @brief Renvoie 1 si le mot est reconnu et 0 sinon.
+ *
+ * Les états et transitions calculés sont conservés d'un appel à l'autre.
+ *
+ * @param automate Un automate paresseux.
+ * @param mot Le mot à reconnaître.
+ * @param longueur La longueur du mot, en octets.
+ * @return 1 ou 0.
+ */
+int le_mot_est_reconnu_paresseux(
+	Automate_paresseux* automate, const char* mot, size_t longueur
+);
+
+#endif
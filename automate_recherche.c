@@ -0,0 +1,193 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "automate_recherche.h"
+#include "outils.h"
+
+#include <stdint.h>
+#include <string.h>
+
+/*
+ * Renvoie un automate qui reconnaît Σ*L, où L est le langage de
+ * l'automate et Σ son alphabet : un nouvel état initial boucle sur 
+ * toutes les lettres et fait aussi tout ce que font les états initiaux.
+ */
+static Automate* creer_automate_prefixe( const Automate* automate ){
+	Automate* res = copier_automate( automate );
+	int debut = get_max_etat( automate ) + 1;
+	Ensemble_iterateur it_lettre, it_initial, it_fin;
+
+	ajouter_etat( res, debut );
+	for(
+		it_lettre = premier_iterateur_ensemble( get_alphabet( automate ) );
+		! iterateur_ensemble_est_vide( it_lettre );
+		it_lettre = iterateur_suivant_ensemble( it_lettre )
+	){
+		char lettre = (char) get_element( it_lettre );
+		ajouter_transition( res, debut, lettre, debut );
+		for(
+			it_initial = premier_iterateur_ensemble( get_initiaux( automate ) );
+			! iterateur_ensemble_est_vide( it_initial );
+			it_initial = iterateur_suivant_ensemble( it_initial )
+		){
+			const Ensemble* fins = voisins( automate, get_element( it_initial ), lettre );
+			for(
+				it_fin = premier_iterateur_ensemble( fins );
+				! iterateur_ensemble_est_vide( it_fin );
+				it_fin = iterateur_suivant_ensemble( it_fin )
+			){
+				ajouter_transition( res, debut, lettre, get_element( it_fin ) );
+			}
+		}
+	}
+	for(
+		it_initial = premier_iterateur_ensemble( get_initiaux( automate ) );
+		! iterateur_ensemble_est_vide( it_initial );
+		it_initial = iterateur_suivant_ensemble( it_initial )
+	){
+		if( est_un_etat_final_de_l_automate( automate, get_element( it_initial ) ) ){
+			ajouter_etat_final( res, debut );
+		}
+	}
+	vider_ensemble( res->initiaux );
+	ajouter_etat_initial( res, debut );
+	return res;
+}
+
+/*
+ * Compile l'automate qui reconnaît Σ*L. Un octet hors de l'alphabet ne 
+ * laisse que le nouvel état initial, qui est l'état initial du compilé.
+ */
+static Automate_compile* compiler_recherche( const Automate* automate ){
+	Automate* prefixe = creer_automate_prefixe( automate );
+	Automate_compile* res = compiler_automate( prefixe );
+	liberer_automate( prefixe );
+	int q;
+	for( q = 0; q < res->nb_etats; q++ ){
+		if( q != res->puits ){
+			res->transitions[ q * res->nb_classes ] = res->initial;
+		}
+	}
+	return res;
+}
+
+Automate_recherche* creer_automate_recherche( const Automate* automate ){
+	Automate_recherche* res = xmalloc( sizeof(Automate_recherche) );
+	Automate* inverse = miroir( automate );
+	res->avant = compiler_automate( automate );
+	res->arriere = compiler_automate( inverse );
+	res->recherche = compiler_recherche( automate );
+	res->recherche_arriere = compiler_recherche( inverse );
+	liberer_automate( inverse );
+	return res;
+}
+
+void liberer_automate_recherche( Automate_recherche* automate ){
+	if( automate ){
+		liberer_automate_compile( automate->avant );
+		liberer_automate_compile( automate->arriere );
+		liberer_automate_compile( automate->recherche );
+		liberer_automate_compile( automate->recherche_arriere );
+		xfree( automate );
+	}
+}
+
+void pour_toute_occurrence(
+	const Automate_recherche* automate, const char* texte, size_t longueur,
+	void (* action )( size_t debut, size_t fin, void* data ), void* data
+){
+	const Automate_compile* recherche = automate->recherche;
+	const Automate_compile* arriere = automate->arriere;
+	const unsigned char* octets = (const unsigned char*) texte;
+	int etat = recherche->initial;
+	size_t fin = 0;
+	for( ;; ){
+		if( est_final_compile( recherche, etat ) ){
+			int etat_arriere = arriere->initial;
+			size_t debut = fin;
+			if( est_final_compile( arriere, etat_arriere ) ){
+				action( fin, fin, data );
+			}
+			while( debut > 0 ){
+				debut--;
+				etat_arriere = transition_compile( arriere, etat_arriere, octets[debut] );
+				if( etat_arriere == arriere->puits ) break;
+				if( est_final_compile( arriere, etat_arriere ) ){
+					action( debut, fin, data );
+				}
+			}
+		}
+		if( fin == longueur ) break;
+		etat = transition_compile( recherche, etat, octets[fin] );
+		fin++;
+	}
+}
+
+void pour_toute_occurrence_la_plus_longue(
+	const Automate_recherche* automate, const char* texte, size_t longueur,
+	void (* action )( size_t debut, size_t fin, void* data ), void* data
+){
+	const Automate_compile* recherche = automate->recherche_arriere;
+	const Automate_compile* avant = automate->avant;
+	const unsigned char* octets = (const unsigned char*) texte;
+
+	// debuts : le bit i vaut 1 si une occurrence commence en i.
+	size_t nb_mots = longueur / 64 + 1;
+	uint64_t* debuts = xmalloc( nb_mots * sizeof(uint64_t) );
+	memset( debuts, 0, nb_mots * sizeof(uint64_t) );
+	int etat = recherche->initial;
+	size_t i = longueur;
+	for( ;; ){
+		if( est_final_compile( recherche, etat ) ){
+			debuts[ i / 64 ] |= (uint64_t) 1 << ( i % 64 );
+		}
+		if( i == 0 ) break;
+		i--;
+		etat = transition_compile( recherche, etat, octets[i] );
+	}
+
+	size_t position = 0;
+	size_t mot = 0;
+	while( mot < nb_mots ){
+		uint64_t bits = debuts[mot];
+		if( mot == position / 64 ){
+			bits &= ~(uint64_t) 0 << ( position % 64 );
+		}
+		if( ! bits ){
+			mot++;
+			continue;
+		}
+		size_t debut = mot * 64 + __builtin_ctzll( bits );
+
+		// L'occurrence la plus longue qui commence en debut.
+		size_t fin = debut;
+		etat = avant->initial;
+		for( i = debut; i < longueur; i++ ){
+			etat = transition_compile( avant, etat, octets[i] );
+			if( etat == avant->puits ) break;
+			if( est_final_compile( avant, etat ) ) fin = i + 1;
+		}
+		action( debut, fin, data );
+
+		position = ( fin > debut ) ? fin : debut + 1;
+		mot = position / 64;
+	}
+	xfree( debuts );
+}
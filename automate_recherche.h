@@ -0,0 +1,122 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file automate_recherche.h */ 
+
+#ifndef __AUTOMATE_RECHERCHE_H__
+#define __AUTOMATE_RECHERCHE_H__
+
+#include <stddef.h>
+
+#include "automate.h"
+#include "automate_compile.h"
+
+/**
+ * @brief Le type d'un automate qui cherche les occurrences d'un langage 
+ *        L dans un texte.
+ *
+ * Une occurrence est un couple (debut, fin) tel que le facteur 
+ * texte[debut..fin-1] est dans L. Pour ne pas relancer l'automate depuis 
+ * chaque position, quatre automates compilés sont construits une fois :
+ *
+ * - 'recherche' reconnaît Σ*L : il est dans un état final après la 
+ *   lecture de texte[0..fin-1] si et seulement si une occurrence se 
+ *   termine en 'fin'.
+ * - 'recherche_arriere' reconnaît Σ*miroir(L) : lu de droite à gauche, il 
+ *   trouve de même les positions où commence une occurrence.
+ * - 'avant' reconnaît L et 'arriere' reconnaît miroir(L) : partant d'un 
+ *   début (resp. d'une fin), ils trouvent les fins (resp. les débuts) des 
+ *   occurrences correspondantes.
+ *
+ * Les octets qui ne sont pas dans l'alphabet de L ne peuvent être dans
+ * aucune occurrence : dans 'recherche' et 'recherche_arriere', ils 
+ * ramènent à l'état initial au lieu du puits.
+ */
+struct Automate_recherche {
+	Automate_compile* avant;
+	Automate_compile* arriere;
+	Automate_compile* recherche;
+	Automate_compile* recherche_arriere;
+};
+
+typedef struct Automate_recherche Automate_recherche;
+
+/**
+ * @brief Crée l'automate qui cherche les occurrences du langage d'un 
+ *        automate.
+ *
+ * @param automate Un automate.
+ * @return L'automate de recherche, à libérer avec 
+ *         liberer_automate_recherche().
+ */
+Automate_recherche* creer_automate_recherche( const Automate* automate );
+
+/**
+ * @brief Libère la mémoire d'un automate de recherche.
+ *
+ * @param automate L'automate de recherche à libérer.
+ */
+void liberer_automate_recherche( Automate_recherche* automate );
+
+/**
+ * @brief Exécute une action pour toutes les occurrences d'un texte.
+ *
+ * Les fins des occurrences sont trouvées en une lecture du texte, de 
+ * gauche à droite. Depuis chaque fin, le texte est relu de droite à 
+ * gauche jusqu'à ce qu'aucun début ne soit plus possible. 
+ * Les occurrences sont donc données par fin croissante et, pour une même 
+ * fin, par début décroissant.
+ *
+ * @param automate Un automate de recherche.
+ * @param texte Le texte, qui peut contenir des octets nuls.
+ * @param longueur La longueur du texte, en octets.
+ * @param action L'action à exécuter sur chaque occurrence.
+ * @param data Le dernier paramètre de l'action.
+ */
+void pour_toute_occurrence(
+	const Automate_recherche* automate, const char* texte, size_t longueur,
+	void (* action )( size_t debut, size_t fin, void* data ), void* data
+);
+
+/**
+ * @brief Exécute une action pour les occurrences les plus à gauche, puis
+ *        les plus longues, d'un texte.
+ *
+ * L'occurrence choisie est celle qui commence le plus à gauche et, parmi 
+ * celles-ci, la plus longue. La recherche reprend à sa fin (ou à la 
+ * position suivante si elle est vide) : les occurrences données ne se 
+ * chevauchent pas.
+ *
+ * Une seule lecture du texte de droite à gauche marque toutes les 
+ * positions où commence une occurrence ; la fin de chaque occurrence est
+ * ensuite trouvée en lisant depuis son début.
+ *
+ * @param automate Un automate de recherche.
+ * @param texte Le texte, qui peut contenir des octets nuls.
+ * @param longueur La longueur du texte, en octets.
+ * @param action L'action à exécuter sur chaque occurrence.
+ * @param data Le dernier paramètre de l'action.
+ */
+void pour_toute_occurrence_la_plus_longue(
+	const Automate_recherche* automate, const char* texte, size_t longueur,
+	void (* action )( size_t debut, size_t fin, void* data ), void* data
+);
+
+#endif
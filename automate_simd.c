@@ -0,0 +1,164 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "automate_simd.h"
+#include "automate_compile.h"
+#include "outils.h"
+
+#include <string.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define AUTOMATE_SIMD_X86
+#include <immintrin.h>
+#endif
+
+/*
+ * Le puits est absorbant : on ne vérifie qu'on l'a atteint que tous les 
+ * AUTOMATE_SIMD_BLOC octets, pour ne pas allonger la boucle. Les octets 
+ * hors de l'alphabet sont cumulés dans 'hors', qui ne dépend pas de 
+ * l'état, et vérifiés au même moment.
+ */
+#define AUTOMATE_SIMD_BLOC 64
+
+static inline uint64_t est_hors_alphabet( 
+	const Automate_simd* automate, unsigned char octet 
+){
+	return automate->hors_alphabet[ octet / 64 ] >> ( octet % 64 );
+}
+
+int le_mot_est_reconnu_simd_scalaire(
+	const Automate_simd* automate, const char* mot, size_t longueur
+){
+	const unsigned char* octets = (const unsigned char*) mot;
+	int etat = automate->initial;
+	uint64_t hors = 0;
+	size_t i = 0;
+	while( i < longueur ){
+		size_t fin = i + AUTOMATE_SIMD_BLOC < longueur ? i + AUTOMATE_SIMD_BLOC : longueur;
+		for( ; i < fin; i++ ){
+			etat = automate->transitions[ octets[i] ][ etat ];
+			hors |= est_hors_alphabet( automate, octets[i] );
+		}
+		if( etat == automate->puits || ( hors & 1 ) ) return 0;
+	}
+	return ( automate->finaux >> etat ) & 1;
+}
+
+#ifdef AUTOMATE_SIMD_X86
+/*
+ * L'état courant est répété dans les 16 octets du registre 'etat' : la 
+ * permutation de transitions[o] par 'etat' donne l'état suivant, répété 
+ * lui aussi.
+ */
+__attribute__(( target( "ssse3" ) ))
+static int le_mot_est_reconnu_ssse3(
+	const Automate_simd* automate, const char* mot, size_t longueur
+){
+	const unsigned char* octets = (const unsigned char*) mot;
+	__m128i etat = _mm_set1_epi8( (char) automate->initial );
+	uint64_t hors = 0;
+	size_t i = 0;
+	while( i < longueur ){
+		size_t fin = i + AUTOMATE_SIMD_BLOC < longueur ? i + AUTOMATE_SIMD_BLOC : longueur;
+		for( ; i < fin; i++ ){
+			__m128i t = _mm_loadu_si128( 
+				(const __m128i*) automate->transitions[ octets[i] ] 
+			);
+			etat = _mm_shuffle_epi8( t, etat );
+			hors |= est_hors_alphabet( automate, octets[i] );
+		}
+		if( 
+			( _mm_cvtsi128_si32( etat ) & 0xff ) == automate->puits 
+			|| ( hors & 1 ) 
+		){
+			return 0;
+		}
+	}
+	return ( automate->finaux >> ( _mm_cvtsi128_si32( etat ) & 0xff ) ) & 1;
+}
+#endif
+
+Automate_simd* creer_automate_simd( const Automate* automate ){
+	Automate_compile* compile = compiler_automate( automate );
+	int o, q;
+
+	// Le puits de l'automate compilé est son dernier état. Il n'est gardé 
+	// que s'il est initial ou si une lettre de l'alphabet y mène : la 
+	// classe 0 est traitée par 'hors_alphabet'.
+	int puits = compile->puits;
+	int puits_utile = compile->initial == puits;
+	for( q = 0; q < puits && ! puits_utile; q++ ){
+		for( o = 0; o < 256; o++ ){
+			if( 
+				compile->classes[o] 
+				&& transition_compile( compile, q, (unsigned char) o ) == puits 
+			){
+				puits_utile = 1;
+				break;
+			}
+		}
+	}
+	int nb_etats = puits_utile ? compile->nb_etats : compile->nb_etats - 1;
+	if( nb_etats > AUTOMATE_SIMD_MAX_ETATS ){
+		liberer_automate_compile( compile );
+		return NULL;
+	}
+
+	Automate_simd* res = xmalloc( sizeof(Automate_simd) );
+	res->nb_etats = nb_etats;
+	res->initial = compile->initial;
+	res->puits = puits_utile ? puits : -1;
+	res->finaux = 0;
+	for( q = 0; q < nb_etats; q++ ){
+		if( est_final_compile( compile, q ) ) res->finaux |= 1u << q;
+	}
+	memset( res->hors_alphabet, 0, sizeof(res->hors_alphabet) );
+	for( o = 0; o < 256; o++ ){
+		if( ! compile->classes[o] ){
+			res->hors_alphabet[ o / 64 ] |= (uint64_t) 1 << ( o % 64 );
+		}
+	}
+	// Les octets hors de l'alphabet et ceux des états qui n'existent pas 
+	// laissent l'état inchangé : le mot est rejeté à la fin du bloc.
+	for( o = 0; o < 256; o++ ){
+		for( q = 0; q < AUTOMATE_SIMD_MAX_ETATS; q++ ){
+			res->transitions[o][q] = q < nb_etats && compile->classes[o] ?
+				transition_compile( compile, q, (unsigned char) o ) : q;
+		}
+	}
+	liberer_automate_compile( compile );
+
+	res->reconnaitre = le_mot_est_reconnu_simd_scalaire;
+#ifdef AUTOMATE_SIMD_X86
+	__builtin_cpu_init();
+	if( __builtin_cpu_supports( "ssse3" ) ){
+		res->reconnaitre = le_mot_est_reconnu_ssse3;
+	}
+#endif
+	return res;
+}
+
+void liberer_automate_simd( Automate_simd* automate ){
+	xfree( automate );
+}
+
+int automate_simd_est_vectoriel( const Automate_simd* automate ){
+	return automate->reconnaitre != le_mot_est_reconnu_simd_scalaire;
+}
@@ -0,0 +1,127 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file automate_simd.h */ 
+
+#ifndef __AUTOMATE_SIMD_H__
+#define __AUTOMATE_SIMD_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "automate.h"
+
+/**
+ * Nombre maximal d'états, puits compris, d'un automate à instructions 
+ * vectorielles.
+ */
+#define AUTOMATE_SIMD_MAX_ETATS 16
+
+/**
+ * @brief Le type d'un automate déterministe d'au plus 16 états, qui 
+ *        reconnaît les mots avec des instructions vectorielles.
+ *
+ * Pour chaque octet o, transitions[o] contient sur 16 octets l'état 
+ * atteint depuis chacun des états en lisant o. Une transition est donc 
+ * une seule permutation d'octets (pshufb en SSSE3) de transitions[o] par
+ * l'état courant : le chargement de transitions[o] ne dépend que du mot,
+ * et pas de l'état courant.
+ *
+ * Les octets hors de l'alphabet n'ont pas besoin d'un état : ce sont ceux
+ * dont le bit est à 1 dans le tableau de bits 'hors_alphabet', vérifié 
+ * une fois par bloc d'octets. Le puits, s'il existe, est l'état atteint 
+ * par les lettres qui ne mènent à aucun état final ; 'puits' vaut -1 si 
+ * aucune lettre n'y mène.
+ *
+ * La fonction 'reconnaitre' est choisie à la création selon le processeur :
+ * la version SSSE3 si elle est disponible, la version scalaire sinon.
+ */
+typedef struct Automate_simd {
+	int nb_etats;
+	int initial;
+	int puits;
+	unsigned finaux;
+	uint64_t hors_alphabet[4];
+	int (*reconnaitre)( 
+		const struct Automate_simd* automate, const char* mot, size_t longueur 
+	);
+	unsigned char transitions[256][AUTOMATE_SIMD_MAX_ETATS];
+} Automate_simd;
+
+/**
+ * @brief Crée un automate à instructions vectorielles.
+ *
+ * L'automate est d'abord compilé (voir compiler_automate()) : il est 
+ * déterminisé s'il ne l'est pas, et ses états depuis lesquels aucun état 
+ * final n'est accessible sont regroupés dans un puits. Ce puits n'est 
+ * gardé que si une lettre de l'alphabet y mène. Pour un automate minimal
+ * (voir creer_automate_minimal()), le nombre d'états est donc celui de 
+ * l'automate, plus un s'il manque des transitions sur des lettres de 
+ * l'alphabet et qu'il n'a pas d'état mort.
+ *
+ * @param automate Un automate.
+ * @return L'automate à instructions vectorielles, à libérer avec 
+ *         liberer_automate_simd(), ou NULL si l'automate compilé a plus de
+ *         AUTOMATE_SIMD_MAX_ETATS états.
+ */
+Automate_simd* creer_automate_simd( const Automate* automate );
+
+/**
+ * @brief Libère la mémoire d'un automate à instructions vectorielles.
+ *
+ * @param automate L'automate à libérer.
+ */
+void liberer_automate_simd( Automate_simd* automate );
+
+/**
+ * @brief Renvoie 1 si le mot est reconnu et 0 sinon.
+ *
+ * Le mot est donné par un pointeur et une longueur : il peut contenir des 
+ * octets nuls. Aucune allocation n'est faite.
+ *
+ * @param automate Un automate à instructions vectorielles.
+ * @param mot Le mot à reconnaître.
+ * @param longueur La longueur du mot, en octets.
+ * @return 1 ou 0.
+ */
+static inline int le_mot_est_reconnu_simd(
+	const Automate_simd* automate, const char* mot, size_t longueur
+){
+	return automate->reconnaitre( automate, mot, longueur );
+}
+
+/**
+ * @brief La version scalaire de le_mot_est_reconnu_simd(), utilisée quand
+ *        le processeur n'a pas d'instructions SSSE3.
+ */
+int le_mot_est_reconnu_simd_scalaire(
+	const Automate_simd* automate, const char* mot, size_t longueur
+);
+
+/**
+ * @brief Renvoie 1 si le_mot_est_reconnu_simd() utilise les instructions 
+ *        SSSE3 et 0 sinon.
+ *
+ * @param automate Un automate à instructions vectorielles.
+ * @return 1 ou 0.
+ */
+int automate_simd_est_vectoriel( const Automate_simd* automate );
+
+#endif
@@ -0,0 +1,94 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Compare, en microsecondes par octet lu, la simulation bit à bit d'un 
+ * automate de Glushkov et la simulation par ensembles de sa copie, qui 
+ * n'est pas simulée bit à bit.
+ *
+ * L'automate, celui de (a+b)*.w pour un mot w fixé, n'a que quelques 
+ * états courants à la fois, quel que soit son nombre de positions : c'est
+ * le cas le moins favorable aux tables de suivants.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "automate_bits.h"
+#include "rationnel.h"
+#include "outils.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define LONGUEUR_TEXTE 20000
+
+static double secondes(){
+	struct timespec t;
+	clock_gettime( CLOCK_MONOTONIC, &t );
+	return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+int main(){
+	const int positions[] = { 100, 1000, 2000, 4000 };
+	char* texte = xmalloc( LONGUEUR_TEXTE + 1 );
+	int i, j;
+	srand( 1 );
+	for( i = 0; i < LONGUEUR_TEXTE; i++ ) texte[i] = "ab"[ rand() % 2 ];
+	texte[LONGUEUR_TEXTE] = '\0';
+
+	printf( "%10s %8s %14s %14s\n", "positions", "largeur", "bits (us/o)", 
+		"ensembles (us/o)" 
+	);
+	for( i = 0; i < sizeof(positions)/sizeof(positions[0]); i++ ){
+		char* expression = xmalloc( 2 * positions[i] + 16 );
+		strcpy( expression, "(a+b)*" );
+		char* fin_expression = expression + strlen( expression );
+		for( j = 0; j < positions[i]; j++ ){
+			*fin_expression++ = '.';
+			*fin_expression++ = "ab"[ rand() % 2 ];
+		}
+		*fin_expression = '\0';
+		Rationnel * rat = expression_to_rationnel( expression );
+		Automate * automate = Glushkov( rat );
+		Automate * copie = copier_automate( automate );
+
+		double debut = secondes();
+		int reconnu_bits = le_mot_est_reconnu( automate, texte );
+		double milieu = secondes();
+		int reconnu_ensembles = le_mot_est_reconnu( copie, texte );
+		double fin = secondes();
+		if( reconnu_bits != reconnu_ensembles ){
+			ERREUR( "Les deux simulations ne reconnaissent pas le même mot" );
+		}
+		printf( "%10d %8d %14.3f %14.3f\n", positions[i], 
+			simulation_automate( automate )->largeur,
+			( milieu - debut ) * 1e6 / LONGUEUR_TEXTE, 
+			( fin - milieu ) * 1e6 / LONGUEUR_TEXTE
+		);
+
+		liberer_automate( copie );
+		liberer_automate( automate );
+		xfree( expression );
+	}
+	xfree( texte );
+	return 0;
+}
@@ -0,0 +1,118 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Mesure le débit, en mots par seconde, de la reconnaissance d'un lot de
+ * mots aléatoires : mot par mot, en avançant plusieurs mots à la fois, 
+ * puis selon le nombre de fils d'exécution.
+ *
+ * L'automate, celui de (a+b+c)*.a.(a+b+c)^12, a 2^13 états : sa table de 
+ * transitions ne tient pas dans le cache L1.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "automate_lot.h"
+#include "rationnel.h"
+#include "outils.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define NB_MOTS 500000
+#define LONGUEUR_MAX 128
+
+static double secondes(){
+	struct timespec t;
+	clock_gettime( CLOCK_MONOTONIC, &t );
+	return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+int main(){
+	char expression[256] = "(a+b+c)*.a";
+	int i, j;
+	for( i = 0; i < 12; i++ ) strcat( expression, ".(a+b+c)" );
+	Rationnel * rat = expression_to_rationnel( expression );
+	Automate * automate = Glushkov( rat );
+	Automate_compile * compile = compiler_automate( automate );
+
+	char* textes = xmalloc( (size_t) NB_MOTS * LONGUEUR_MAX );
+	Mot* mots = xmalloc( NB_MOTS * sizeof(Mot) );
+	uint64_t* resultats = xmalloc( ( NB_MOTS + 63 ) / 64 * sizeof(uint64_t) );
+	srand( 1 );
+	for( i = 0; i < NB_MOTS; i++ ){
+		char* texte = textes + (size_t) i * LONGUEUR_MAX;
+		mots[i].octets = texte;
+		mots[i].longueur = 1 + rand() % LONGUEUR_MAX;
+		for( j = 0; j < mots[i].longueur; j++ ){
+			texte[j] = "abc"[ rand() % 3 ];
+		}
+	}
+
+	printf( "%-14s %14s %10s\n", "", "mots/s", "reconnus" );
+	double debut = secondes();
+	int nb_reconnus = 0;
+	for( i = 0; i < NB_MOTS; i++ ){
+		nb_reconnus += le_mot_est_reconnu_compile( 
+			compile, mots[i].octets, mots[i].longueur 
+		);
+	}
+	double fin = secondes();
+	printf( "%-14s %14.0f %10d\n", "mot par mot", NB_MOTS / ( fin - debut ), nb_reconnus );
+	int nb_flux;
+	for( nb_flux = 4; nb_flux <= AUTOMATE_LOT_MAX_FLUX; nb_flux += 4 ){
+		debut = secondes();
+		reconnaitre_mots_entrelaces( compile, mots, NB_MOTS, resultats, nb_flux );
+		fin = secondes();
+		nb_reconnus = 0;
+		for( i = 0; i < ( NB_MOTS + 63 ) / 64; i++ ){
+			nb_reconnus += __builtin_popcountll( resultats[i] );
+		}
+		printf( "%2d %-11s %14.0f %10d\n", 
+			nb_flux, "flux", NB_MOTS / ( fin - debut ), nb_reconnus 
+		);
+	}
+	printf( "\n" );
+
+	long nb_processeurs = sysconf( _SC_NPROCESSORS_ONLN );
+	if( nb_processeurs < 1 ) nb_processeurs = 1;
+	printf( "%6s %14s %10s\n", "fils", "mots/s", "reconnus" );
+	int nb_fils;
+	for( nb_fils = 1; nb_fils <= nb_processeurs; nb_fils++ ){
+		debut = secondes();
+		reconnaitre_lot_compile( compile, mots, NB_MOTS, resultats, nb_fils );
+		fin = secondes();
+		nb_reconnus = 0;
+		for( i = 0; i < ( NB_MOTS + 63 ) / 64; i++ ){
+			nb_reconnus += __builtin_popcountll( resultats[i] );
+		}
+		printf( "%6d %14.0f %10d\n", nb_fils, NB_MOTS / ( fin - debut ), nb_reconnus );
+	}
+
+	xfree( resultats );
+	xfree( mots );
+	xfree( textes );
+	liberer_automate_compile( compile );
+	liberer_automate( automate );
+	return 0;
+}
@@ -0,0 +1,113 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Mesure le nombre d'allocations et le temps de la déterminisation de 
+ * l'automate de (a+b)*.a.(a+b)^k, dont le déterminisé a 2^(k+1) états, 
+ * avec les réserves (voir reserve.h) et avec leurs noeuds alloués un à un
+ * par xmalloc(), puis le temps écoulé de la déterminisation parallèle 
+ * selon le nombre de fils d'exécution.
+ *
+ * La ligne « xmalloc » isole le seul coût des noeuds : ce n'est pas la 
+ * bibliothèque d'avant les réserves, qui allouait aussi une association 
+ * et une copie de la clé à chaque recherche. Pour k = 14, celle-ci 
+ * faisait 52 appels à malloc() par état, contre 12 pour la ligne 
+ * « xmalloc » et 10 avec les réserves.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "automate.h"
+#include "automate_parallele.h"
+#include "reserve.h"
+#include "outils.h"
+
+#include <stdio.h>
+#include <time.h>
+
+static Automate * creer_automate_k( int k ){
+	Automate * automate = creer_automate();
+	ajouter_etat_initial( automate, 0 );
+	ajouter_transition( automate, 0, 'a', 0 );
+	ajouter_transition( automate, 0, 'b', 0 );
+	ajouter_transition( automate, 0, 'a', 1 );
+	int i;
+	for( i = 1; i <= k; i++ ){
+		ajouter_transition( automate, i, 'a', i+1 );
+		ajouter_transition( automate, i, 'b', i+1 );
+	}
+	ajouter_etat_final( automate, k+1 );
+	return automate;
+}
+
+static double secondes(){
+	struct timespec t;
+	clock_gettime( CLOCK_MONOTONIC, &t );
+	return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+/*
+ * Déterminise les automates de k = 4 à 14, avec les réserves si 'directe'
+ * vaut 0 et sans elles sinon.
+ */
+static void mesurer_allocations( int directe ){
+	int k;
+	utiliser_reserves_directes( directe );
+	for( k = 4; k <= 14; k += 2 ){
+		Automate * automate = creer_automate_k( k );
+		size_t avant = nombre_allocations();
+		clock_t debut = clock();
+		Automate * det = creer_automate_deterministe( automate );
+		clock_t fin = clock();
+		size_t allocations = nombre_allocations() - avant;
+		int nb_etats = taille_ensemble( get_etats( det ) );
+		printf( "%-8s %4d %10d %14zu %16.1f %10.3f\n", 
+			directe ? "xmalloc" : "reserve",
+			k, nb_etats, allocations, (double) allocations / nb_etats,
+			(double) ( fin - debut ) / CLOCKS_PER_SEC
+		);
+		liberer_automate( det );
+		liberer_automate( automate );
+	}
+	utiliser_reserves_directes( 0 );
+}
+
+int main(){
+	int k;
+	printf( "%-8s %4s %10s %14s %16s %10s\n", 
+		"tables", "k", "etats", "allocations", "allocs/etat", "temps (s)" 
+	);
+	mesurer_allocations( 1 );
+	mesurer_allocations( 0 );
+
+	printf( "\n%4s %10s %10s\n", "k", "fils", "temps (s)" );
+	k = 14;
+	Automate * automate = creer_automate_k( k );
+	int nb_fils;
+	for( nb_fils = 1; nb_fils <= 8; nb_fils *= 2 ){
+		double debut = secondes();
+		Automate * det = creer_automate_deterministe_parallele( automate, nb_fils );
+		double fin = secondes();
+		printf( "%4d %10d %10.3f\n", k, nb_fils, fin - debut );
+		liberer_automate( det );
+	}
+	liberer_automate( automate );
+	return 0;
+}
@@ -0,0 +1,154 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "dictionnaire.h"
+#include "outils.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * Les cases de la table de hachage contiennent l'identifiant de l'ensemble
+ * (-1 pour une case vide). Le hachage de chaque ensemble est conservé pour
+ * éviter de recomparer des ensembles de hachages différents et pour 
+ * redimensionner la table sans rehacher.
+ */
+struct Dictionnaire {
+	int* cases;
+	size_t nb_cases;
+	Ensemble** ensembles;
+	uint64_t* hachages;
+	int taille;
+	int capacite;
+};
+
+Dictionnaire* creer_dictionnaire(){
+	Dictionnaire* res = xmalloc( sizeof(Dictionnaire) );
+	res->nb_cases = 16;
+	res->cases = xmalloc( res->nb_cases * sizeof(int) );
+	memset( res->cases, -1, res->nb_cases * sizeof(int) );
+	res->capacite = 8;
+	res->ensembles = xmalloc( res->capacite * sizeof(Ensemble*) );
+	res->hachages = xmalloc( res->capacite * sizeof(uint64_t) );
+	res->taille = 0;
+	return res;
+}
+
+void liberer_dictionnaire( Dictionnaire* dictionnaire ){
+	int i;
+	for( i = 0; i < dictionnaire->taille; i++ ){
+		liberer_ensemble( dictionnaire->ensembles[i] );
+	}
+	xfree( dictionnaire->ensembles );
+	xfree( dictionnaire->hachages );
+	xfree( dictionnaire->cases );
+	xfree( dictionnaire );
+}
+
+/*
+ * Renvoie la case contenant l'ensemble, ou la case vide où il doit être
+ * rangé.
+ */
+static size_t trouver_case(
+	const Dictionnaire* dictionnaire, const Ensemble* ensemble, uint64_t h
+){
+	size_t masque = dictionnaire->nb_cases - 1;
+	size_t i = h & masque;
+	while( dictionnaire->cases[i] >= 0 ){
+		int id = dictionnaire->cases[i];
+		if( 
+			dictionnaire->hachages[id] == h && 
+			comparer_ensemble( dictionnaire->ensembles[id], ensemble ) == 0
+		){
+			return i;
+		}
+		i = ( i + 1 ) & masque;
+	}
+	return i;
+}
+
+static void agrandir_cases( Dictionnaire* dictionnaire ){
+	int i;
+	xfree( dictionnaire->cases );
+	dictionnaire->nb_cases *= 2;
+	dictionnaire->cases = xmalloc( dictionnaire->nb_cases * sizeof(int) );
+	memset( dictionnaire->cases, -1, dictionnaire->nb_cases * sizeof(int) );
+	size_t masque = dictionnaire->nb_cases - 1;
+	for( i = 0; i < dictionnaire->taille; i++ ){
+		size_t c = dictionnaire->hachages[i] & masque;
+		while( dictionnaire->cases[c] >= 0 ){
+			c = ( c + 1 ) & masque;
+		}
+		dictionnaire->cases[c] = i;
+	}
+}
+
+int identifiant_ensemble( 
+	Dictionnaire* dictionnaire, Ensemble* ensemble, int* nouveau
+){
+	uint64_t h = hacher_ensemble( ensemble );
+	size_t c = trouver_case( dictionnaire, ensemble, h );
+	if( dictionnaire->cases[c] >= 0 ){
+		liberer_ensemble( ensemble );
+		if( nouveau ) *nouveau = 0;
+		return dictionnaire->cases[c];
+	}
+
+	if( dictionnaire->taille == dictionnaire->capacite ){
+		dictionnaire->capacite *= 2;
+		dictionnaire->ensembles = xrealloc(
+			dictionnaire->ensembles, 
+			dictionnaire->capacite * sizeof(Ensemble*)
+		);
+		dictionnaire->hachages = xrealloc(
+			dictionnaire->hachages, 
+			dictionnaire->capacite * sizeof(uint64_t)
+		);
+	}
+	int id = dictionnaire->taille++;
+	dictionnaire->ensembles[id] = ensemble;
+	dictionnaire->hachages[id] = h;
+	dictionnaire->cases[c] = id;
+	// On garde un taux de remplissage inférieur à 1/2.
+	if( 2 * (size_t) dictionnaire->taille > dictionnaire->nb_cases ){
+		agrandir_cases( dictionnaire );
+	}
+	if( nouveau ) *nouveau = 1;
+	return id;
+}
+
+int chercher_dictionnaire( 
+	const Dictionnaire* dictionnaire, const Ensemble* ensemble
+){
+	size_t c = trouver_case( 
+		dictionnaire, ensemble, hacher_ensemble( ensemble )
+	);
+	return dictionnaire->cases[c];
+}
+
+const Ensemble* ensemble_de_identifiant( 
+	const Dictionnaire* dictionnaire, int identifiant
+){
+	return dictionnaire->ensembles[identifiant];
+}
+
+int taille_dictionnaire( const Dictionnaire* dictionnaire ){
+	return dictionnaire->taille;
+}
@@ -0,0 +1,86 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux.
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef __DICTIONNAIRE_H__
+#define __DICTIONNAIRE_H__
+
+#include "ensemble.h"
+
+/*
+ * Définit le type d'un dictionnaire d'ensembles d'entiers.
+ *
+ * Un dictionnaire associe à chaque ensemble qu'il contient un identifiant.
+ * Les identifiants sont attribués dans l'ordre d'insertion, à partir de 0.
+ * Les ensembles sont rangés dans une table de hachage (voir 
+ * hacher_ensemble()), ce qui permet de retrouver l'identifiant d'un 
+ * ensemble en une seule recherche.
+ */
+typedef struct Dictionnaire Dictionnaire;
+
+/*
+ * Renvoie un nouveau dictionnaire vide.
+ */
+Dictionnaire* creer_dictionnaire();
+
+/*
+ * Libère la mémoire d'un dictionnaire et de tous les ensembles qu'il 
+ * contient.
+ */
+void liberer_dictionnaire( Dictionnaire* dictionnaire );
+
+/*
+ * Renvoie l'identifiant de l'ensemble passé en paramètre.
+ *
+ * Si l'ensemble n'est pas encore dans le dictionnaire, il y est ajouté avec
+ * le prochain identifiant libre, et 'nouveau' (s'il est non NULL) est mis 
+ * à 1. Sinon, 'nouveau' est mis à 0.
+ *
+ * Le dictionnaire devient responsable de la mémoire de l'ensemble passé en
+ * paramètre : si un ensemble égal était déjà présent, l'ensemble passé en
+ * paramètre est libéré.
+ */
+int identifiant_ensemble( 
+	Dictionnaire* dictionnaire, Ensemble* ensemble, int* nouveau
+);
+
+/*
+ * Renvoie l'identifiant de l'ensemble passé en paramètre, ou -1 s'il n'est
+ * pas dans le dictionnaire. L'ensemble n'est ni ajouté ni libéré.
+ */
+int chercher_dictionnaire( 
+	const Dictionnaire* dictionnaire, const Ensemble* ensemble
+);
+
+/*
+ * Renvoie l'ensemble associé à un identifiant.
+ *
+ * La mémoire de l'ensemble renvoyé est gérée par le dictionnaire.
+ */
+const Ensemble* ensemble_de_identifiant( 
+	const Dictionnaire* dictionnaire, int identifiant
+);
+
+/*
+ * Renvoie le nombre d'ensembles du dictionnaire.
+ */
+int taille_dictionnaire( const Dictionnaire* dictionnaire );
+
+#endif
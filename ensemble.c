@@ -27,6 +27,7 @@
 
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 
 
 int* allouer_element( int val ){
@@ -39,37 +40,286 @@ void supprimer_element( int* element ){
 	xfree( element );
 }
 
-void next_iterators( Table_iterateur * it1, Table_iterateur * it2 ){
-	*it1 = iterateur_suivant_table(*it1);
-	*it2 = iterateur_suivant_table(*it2);
+/*
+ * Fonctions de manipulation des ensembles codés par un tableau de bits.
+ * 
+ * Les indices de mots sont absolus : l'élément e se trouve dans le mot 
+ * d'indice mot_de(e), c'est-à-dire dans la case 
+ * ens->mots[ mot_de(e) - ens->premier_mot ].
+ */
+
+static int est_en_bits( const Ensemble* ens ){
+	return ens->table == NULL;
+}
+
+static intptr_t mot_de( intptr_t element ){
+	if( element >= 0 ) return element / 64;
+	return - ( ( -( element + 1 ) ) / 64 ) - 1;
+}
+
+static int bit_de( intptr_t element ){
+	return (int) ( element - 64 * mot_de( element ) );
+}
+
+static uint64_t lire_mot( const Ensemble* ens, intptr_t mot ){
+	intptr_t i = mot - ens->premier_mot;
+	if( i < 0 || i >= (intptr_t) ens->nb_mots ) return 0;
+	return ens->mots[i];
+}
+
+/*
+ * Élargit la fenêtre de mots de l'ensemble pour qu'elle contienne les mots
+ * d'indices 'debut' à 'fin'. Renvoie 0 si la fenêtre obtenue dépasserait 
+ * ENSEMBLE_BITS_MAX_MOTS mots.
+ */
+static int etendre_mots( Ensemble* ens, intptr_t debut, intptr_t fin ){
+	intptr_t lo = debut, hi = fin;
+	if( ens->nb_mots ){
+		intptr_t ancien_lo = ens->premier_mot;
+		intptr_t ancien_hi = ancien_lo + (intptr_t) ens->nb_mots - 1;
+		if( debut >= ancien_lo && fin <= ancien_hi ) return 1;
+		if( ancien_lo < lo ) lo = ancien_lo;
+		if( ancien_hi > hi ) hi = ancien_hi;
+		if( hi - lo + 1 > ENSEMBLE_BITS_MAX_MOTS ) return 0;
+		// On double la fenêtre dans le sens de l'agrandissement pour que 
+		// les ajouts successifs restent en temps amorti constant.
+		intptr_t voulu = 2 * (intptr_t) ens->nb_mots;
+		if( voulu > ENSEMBLE_BITS_MAX_MOTS ) voulu = ENSEMBLE_BITS_MAX_MOTS;
+		if( voulu > hi - lo + 1 ){
+			if( fin > ancien_hi ) hi = lo + voulu - 1;
+			else lo = hi - voulu + 1;
+		}
+	}else if( hi - lo + 1 > ENSEMBLE_BITS_MAX_MOTS ){
+		return 0;
+	}
+	size_t n = (size_t) ( hi - lo + 1 );
+	uint64_t* mots = xmalloc( n * sizeof(uint64_t) );
+	memset( mots, 0, n * sizeof(uint64_t) );
+	if( ens->nb_mots ){
+		memcpy(
+			mots + ( ens->premier_mot - lo ), ens->mots,
+			ens->nb_mots * sizeof(uint64_t)
+		);
+	}
+	xfree( ens->mots );
+	ens->mots = mots;
+	ens->premier_mot = lo;
+	ens->nb_mots = n;
+	return 1;
+}
+
+/*
+ * Cherche le plus petit élément supérieur ou égal à 'depuis'.
+ * Renvoie 0 s'il n'existe pas.
+ */
+static int chercher_bit_suivant(
+	const Ensemble* ens, intptr_t depuis, intptr_t* res
+){
+	intptr_t k = mot_de( depuis ) - ens->premier_mot;
+	uint64_t masque = ~ (uint64_t) 0 << bit_de( depuis );
+	if( k < 0 ){
+		k = 0;
+		masque = ~ (uint64_t) 0;
+	}
+	for( ; k < (intptr_t) ens->nb_mots; k++ ){
+		uint64_t m = ens->mots[k] & masque;
+		if( m ){
+			*res = 64 * ( ens->premier_mot + k ) + __builtin_ctzll( m );
+			return 1;
+		}
+		masque = ~ (uint64_t) 0;
+	}
+	return 0;
+}
+
+/*
+ * Cherche le plus grand élément inférieur ou égal à 'jusqua'.
+ * Renvoie 0 s'il n'existe pas.
+ */
+static int chercher_bit_precedent(
+	const Ensemble* ens, intptr_t jusqua, intptr_t* res
+){
+	intptr_t k = mot_de( jusqua ) - ens->premier_mot;
+	int b = bit_de( jusqua );
+	uint64_t masque = ( b == 63 ) ? ~ (uint64_t) 0 : ( (uint64_t) 1 << (b+1) ) - 1;
+	if( k >= (intptr_t) ens->nb_mots ){
+		k = (intptr_t) ens->nb_mots - 1;
+		masque = ~ (uint64_t) 0;
+	}
+	for( ; k >= 0; k-- ){
+		uint64_t m = ens->mots[k] & masque;
+		if( m ){
+			*res = 64 * ( ens->premier_mot + k ) + 63 - __builtin_clzll( m );
+			return 1;
+		}
+		masque = ~ (uint64_t) 0;
+	}
+	return 0;
+}
+
+/*
+ * Convertit un ensemble codé par un tableau de bits en un ensemble codé
+ * par une table.
+ */
+static void passer_en_table( Ensemble* ens ){
+	Table* table = creer_table( NULL, NULL, NULL );
+	size_t k;
+	for( k = 0; k < ens->nb_mots; k++ ){
+		uint64_t m = ens->mots[k];
+		while( m ){
+			int b = __builtin_ctzll( m );
+			add_table(
+				table, 64 * ( ens->premier_mot + (intptr_t) k ) + b,
+				(intptr_t) NULL
+			);
+			m &= m - 1;
+		}
+	}
+	xfree( ens->mots );
+	ens->mots = NULL;
+	ens->nb_mots = 0;
+	ens->premier_mot = 0;
+	ens->table = table;
+}
+
+/*
+ * Restreint la fenêtre [*debut, *fin] aux mots non nuls de l'ensemble.
+ * Renvoie 0 si l'ensemble est vide.
+ */
+static int mots_non_nuls( const Ensemble* ens, intptr_t* debut, intptr_t* fin ){
+	intptr_t lo = 0, hi = (intptr_t) ens->nb_mots - 1;
+	while( lo <= hi && ! ens->mots[lo] ) lo++;
+	while( hi >= lo && ! ens->mots[hi] ) hi--;
+	if( lo > hi ) return 0;
+	*debut = ens->premier_mot + lo;
+	*fin = ens->premier_mot + hi;
+	return 1;
+}
+
+static int comparer_ensemble_bits( const Ensemble* ens1, const Ensemble* ens2 ){
+	intptr_t d1, f1, d2, f2;
+	int non_vide1 = mots_non_nuls( ens1, &d1, &f1 );
+	int non_vide2 = mots_non_nuls( ens2, &d2, &f2 );
+	if( ! non_vide1 && ! non_vide2 ) return 0;
+	if( ! non_vide1 ) return -1;
+	if( ! non_vide2 ) return 1;
+	intptr_t k;
+	intptr_t debut = ( d1 < d2 ) ? d1 : d2;
+	intptr_t fin = ( f1 > f2 ) ? f1 : f2;
+	for( k = debut; k <= fin; k++ ){
+		uint64_t m1 = lire_mot( ens1, k );
+		uint64_t diff = m1 ^ lire_mot( ens2, k );
+		if( diff ){
+			// x est le plus petit élément de la différence symétrique.
+			// Les deux tuples triés coïncident jusqu'à x. Celui qui contient
+			// x est le plus petit, sauf si l'autre n'a plus d'élément.
+			int b = __builtin_ctzll( diff );
+			intptr_t x = 64 * k + b, y;
+			if( ( m1 >> b ) & 1 ){
+				return chercher_bit_suivant( ens2, x+1, &y ) ? -1 : 1;
+			}else{
+				return chercher_bit_suivant( ens1, x+1, &y ) ? 1 : -1;
+			}
+		}
+	}
+	return 0;
+}
+
+static int comparer_elements( 
+	const Ensemble* ens, const intptr_t elem1, const intptr_t elem2
+){
+	if( ens->comparer_element ){
+		return ens->comparer_element( elem1, elem2 );
+	}
+	if( elem1 < elem2 ) return -1;
+	if( elem1 > elem2 ) return 1;
+	return 0;
+}
+
+void next_iterators( Ensemble_iterateur * it1, Ensemble_iterateur * it2 ){
+	*it1 = iterateur_suivant_ensemble(*it1);
+	*it2 = iterateur_suivant_ensemble(*it2);
 }
 
 int comparer_ensemble( const Ensemble* ens1, const Ensemble*  ens2 ){
-	Table_iterateur it1, it2;
+	if( est_en_bits( ens1 ) && est_en_bits( ens2 ) ){
+		return comparer_ensemble_bits( ens1, ens2 );
+	}
+
+	Ensemble_iterateur it1, it2;
 	
-	it1 = premier_iterateur_table( ens1->table );
-	it2 = premier_iterateur_table( ens2->table );
+	it1 = premier_iterateur_ensemble( ens1 );
+	it2 = premier_iterateur_ensemble( ens2 );
 	for( 
 		;
-		( ! iterateur_est_vide(it1) ) && ( ! iterateur_est_vide(it2) );
+		( ! iterateur_ensemble_est_vide(it1) ) && 
+		( ! iterateur_ensemble_est_vide(it2) );
 		next_iterators( &it1, &it2 )
 	){
-		int cmp;
-		if( ens1->comparer_element ){
-			cmp = ens1->comparer_element( get_cle( it1 ), get_cle( it2 ) );
-		}else{
-			cmp = get_cle( it1 ) -  get_cle( it2 );
-		}
+		int cmp = comparer_elements( 
+			ens1, get_element( it1 ), get_element( it2 )
+		);
 	 	if( cmp > 0 ) return 1;
 	 	if( cmp < 0 ) return -1;
 	}
-	if( iterateur_est_vide(it1) && iterateur_est_vide(it2) )
+	if( iterateur_ensemble_est_vide(it1) && iterateur_ensemble_est_vide(it2) )
 		return 0;
-	if( iterateur_est_vide(it1) ) 
+	if( iterateur_ensemble_est_vide(it1) ) 
 		return -1;
 	return 1;
 }
 
+static uint64_t melanger( uint64_t h, uint64_t v ){
+	h ^= v;
+	h ^= h >> 33;
+	h *= 0xff51afd7ed558ccdULL;
+	h ^= h >> 33;
+	h *= 0xc4ceb9fe1a85ec53ULL;
+	h ^= h >> 33;
+	return h;
+}
+
+uint64_t hacher_ensemble( const Ensemble* ensemble ){
+	uint64_t h = 0;
+	if( ensemble->comparer_element ){
+		return melanger( h, taille_ensemble( ensemble ) );
+	}
+	if( est_en_bits( ensemble ) ){
+		size_t k;
+		for( k = 0; k < ensemble->nb_mots; k++ ){
+			if( ensemble->mots[k] ){
+				h = melanger( h, (uint64_t) ( ensemble->premier_mot + k ) );
+				h = melanger( h, ensemble->mots[k] );
+			}
+		}
+		return h;
+	}
+	// On reconstitue les mots du tableau de bits à partir des éléments 
+	// triés, pour obtenir la même valeur que dans le cas précédent.
+	Ensemble_iterateur it;
+	intptr_t mot_courant = 0;
+	uint64_t bits = 0;
+	for(
+		it = premier_iterateur_ensemble( ensemble );
+		! iterateur_ensemble_est_vide( it );
+		it = iterateur_suivant_ensemble( it )
+	){
+		intptr_t element = get_element( it );
+		if( bits && mot_de( element ) != mot_courant ){
+			h = melanger( h, (uint64_t) mot_courant );
+			h = melanger( h, bits );
+			bits = 0;
+		}
+		mot_courant = mot_de( element );
+		bits |= (uint64_t) 1 << bit_de( element );
+	}
+	if( bits ){
+		h = melanger( h, (uint64_t) mot_courant );
+		h = melanger( h, bits );
+	}
+	return h;
+}
+
 
 Ensemble * creer_ensemble(
 	int (*comparer_element)( const intptr_t elem1, const intptr_t elem2 ),
@@ -77,9 +327,16 @@ Ensemble * creer_ensemble(
 	void (*supprimer_element)(intptr_t elem )
 ){
 	Ensemble * result = (Ensemble*) xmalloc( sizeof(Ensemble) );
-	result->table = creer_table(
-		comparer_element, copier_element, supprimer_element
-	);
+	result->mots = NULL;
+	result->premier_mot = 0;
+	result->nb_mots = 0;
+	if( comparer_element || copier_element || supprimer_element ){
+		result->table = creer_table(
+			comparer_element, copier_element, supprimer_element
+		);
+	}else{
+		result->table = NULL;
+	}
 	result->comparer_element = comparer_element;
 	result->copier_element = copier_element;
 	result->supprimer_element = supprimer_element;
@@ -88,12 +345,24 @@ Ensemble * creer_ensemble(
 
 void liberer_ensemble( Ensemble * ens ){
 	if(ens){
-		liberer_table( ens->table );
+		if( ens->table ){
+			liberer_table( ens->table );
+		}
+		xfree( ens->mots );
 		xfree( ens );
 	}
 }
 
 void ajouter_element( Ensemble * ensemble, const intptr_t element ){
+	if( est_en_bits( ensemble ) ){
+		intptr_t mot = mot_de( element );
+		if( etendre_mots( ensemble, mot, mot ) ){
+			ensemble->mots[ mot - ensemble->premier_mot ] |= 
+				(uint64_t) 1 << bit_de( element );
+			return;
+		}
+		passer_en_table( ensemble );
+	}
 	add_table( ensemble->table, element, (intptr_t) NULL );
 }
 
@@ -103,10 +372,27 @@ void action_ajouter_element( const intptr_t element, void* ens ){
 }
 
 void ajouter_elements( Ensemble * ens1, const Ensemble * ens2 ){
+	if( est_en_bits( ens1 ) && est_en_bits( ens2 ) ){
+		intptr_t debut, fin, k;
+		if( ! mots_non_nuls( ens2, &debut, &fin ) ) return;
+		if( etendre_mots( ens1, debut, fin ) ){
+			for( k = debut; k <= fin; k++ ){
+				ens1->mots[ k - ens1->premier_mot ] |= lire_mot( ens2, k );
+			}
+			return;
+		}
+	}
 	pour_tout_element( ens2, action_ajouter_element, ens1 );
 }
 
 void retirer_element( Ensemble * ensemble, const intptr_t element ){
+	if( est_en_bits( ensemble ) ){
+		intptr_t i = mot_de( element ) - ensemble->premier_mot;
+		if( i >= 0 && i < (intptr_t) ensemble->nb_mots ){
+			ensemble->mots[i] &= ~ ( (uint64_t) 1 << bit_de( element ) );
+		}
+		return;
+	}
 	delete_table( ensemble->table, element );
 }
 
@@ -115,14 +401,31 @@ void action_retirer_elements( const intptr_t element, void* ens ){
 }
 
 void retirer_elements( Ensemble * ens1, const Ensemble * ens2 ){
+	if( est_en_bits( ens1 ) && est_en_bits( ens2 ) ){
+		size_t k;
+		for( k = 0; k < ens1->nb_mots; k++ ){
+			ens1->mots[k] &= ~ lire_mot( ens2, ens1->premier_mot + k );
+		}
+		return;
+	}
 	pour_tout_element( ens2, action_retirer_elements, ens1 );
 }
 
 void vider_ensemble( Ensemble * ensemble ){
+	if( est_en_bits( ensemble ) ){
+		xfree( ensemble->mots );
+		ensemble->mots = NULL;
+		ensemble->nb_mots = 0;
+		ensemble->premier_mot = 0;
+		return;
+	}
 	vider_table( ensemble->table );
 }
 
 int est_dans_l_ensemble( const Ensemble * ensemble, intptr_t element ){
+	if( est_en_bits( ensemble ) ){
+		return ( lire_mot( ensemble, mot_de( element ) ) >> bit_de( element ) ) & 1;
+	}
 	Table_iterateur it = trouver_table( ensemble->table, element );
 	return ! avl_t_is_null( &it ); 
 }
@@ -133,6 +436,13 @@ void action_taille_ensemble( const intptr_t element, void* taille ){
 
 unsigned int taille_ensemble( const Ensemble* ensemble ){
 	int taille = 0;
+	if( est_en_bits( ensemble ) ){
+		size_t k;
+		for( k = 0; k < ensemble->nb_mots; k++ ){
+			taille += __builtin_popcountll( ensemble->mots[k] );
+		}
+		return taille;
+	}
 	pour_tout_element( ensemble, action_taille_ensemble, &taille );
 	return taille;
 }
@@ -179,6 +489,18 @@ void pour_tout_element(
 	void (* action )( const intptr_t element, void* data ),
 	void* data
 ){
+	if( est_en_bits( ensemble ) ){
+		size_t k;
+		for( k = 0; k < ensemble->nb_mots; k++ ){
+			uint64_t m = ensemble->mots[k];
+			while( m ){
+				int b = __builtin_ctzll( m );
+				action( 64 * ( ensemble->premier_mot + (intptr_t) k ) + b, data );
+				m &= m - 1;
+			}
+		}
+		return;
+	}
 	data_pour_tout_element_t data1;
 	data1.action = action;
 	data1.data = data;
@@ -188,9 +510,9 @@ void pour_tout_element(
 }
 
 void swap_ensemble( Ensemble* ens1, Ensemble* ens2 ){
-	void* tmp = ens1->table;
-	ens1->table = ens2->table;
-	ens2->table = tmp;
+	Ensemble tmp = *ens1;
+	*ens1 = *ens2;
+	*ens2 = tmp;
 }
 void deplacer_ensemble( Ensemble* ens1, Ensemble* ens2 ){
 	swap_ensemble( ens1, ens2 );
@@ -202,6 +524,18 @@ Ensemble* copier_ensemble( const Ensemble* ensemble ){
 		ensemble->comparer_element, ensemble->copier_element,
 		ensemble->supprimer_element
 	);
+	if( est_en_bits( ensemble ) ){
+		if( ensemble->nb_mots ){
+			res->mots = xmalloc( ensemble->nb_mots * sizeof(uint64_t) );
+			memcpy(
+				res->mots, ensemble->mots, 
+				ensemble->nb_mots * sizeof(uint64_t)
+			);
+			res->nb_mots = ensemble->nb_mots;
+			res->premier_mot = ensemble->premier_mot;
+		}
+		return res;
+	}
 	ajouter_elements( res, ensemble  );
 	return res;
 }
@@ -224,36 +558,105 @@ Ensemble * creer_intersection_ensemble(
 	const Ensemble* ens1, const Ensemble* ens2
 ){
 	Ensemble *tmp, *res;
+	if( est_en_bits( ens1 ) && est_en_bits( ens2 ) ){
+		size_t k;
+		res = copier_ensemble( ens1 );
+		for( k = 0; k < res->nb_mots; k++ ){
+			res->mots[k] &= lire_mot( ens2, res->premier_mot + k );
+		}
+		return res;
+	}
 	tmp = creer_difference_ensemble( ens1, ens2 );
 	res = creer_difference_ensemble( ens1, tmp );
 	liberer_ensemble( tmp );
 	return res;
 }
 
+static Ensemble_iterateur iterateur_table( Table_iterateur it ){
+	Ensemble_iterateur res;
+	res.avl = it;
+	res.ensemble = NULL;
+	res.element = 0;
+	res.vide = avl_t_is_null( &it );
+	return res;
+}
+
+static Ensemble_iterateur iterateur_bits(
+	const Ensemble* ensemble, int trouve, intptr_t element
+){
+	Ensemble_iterateur res;
+	res.ensemble = ensemble;
+	res.element = element;
+	res.vide = ! trouve;
+	return res;
+}
+
 Ensemble_iterateur trouver_ensemble(
 	const Ensemble* ensemble, const intptr_t element
 ){
-	return trouver_table( ensemble->table, element );
+	if( est_en_bits( ensemble ) ){
+		return iterateur_bits(
+			ensemble, est_dans_l_ensemble( ensemble, element ), element
+		);
+	}
+	return iterateur_table( trouver_table( ensemble->table, element ) );
 }
 
 Ensemble_iterateur premier_iterateur_ensemble( const Ensemble* ensemble ){
-	return premier_iterateur_table( ensemble->table );
+	if( est_en_bits( ensemble ) ){
+		intptr_t element = 0;
+		int trouve = ensemble->nb_mots && chercher_bit_suivant(
+			ensemble, 64 * ensemble->premier_mot, &element
+		);
+		return iterateur_bits( ensemble, trouve, element );
+	}
+	return iterateur_table( premier_iterateur_table( ensemble->table ) );
 }
 
 Ensemble_iterateur iterateur_suivant_ensemble(
 	const Ensemble_iterateur iterateur
 ){
-	return iterateur_suivant_table( iterateur );
+	if( iterateur.vide ) return iterateur;
+	if( iterateur.ensemble ){
+		const Ensemble* ensemble = iterateur.ensemble;
+		if( ! est_en_bits( ensemble ) ){
+			// L'ensemble a été converti en table pendant le parcours.
+			Table_iterateur it = trouver_table( ensemble->table, iterateur.element );
+			return iterateur_table( iterateur_suivant_table( it ) );
+		}
+		intptr_t element = 0;
+		int trouve = chercher_bit_suivant(
+			ensemble, iterateur.element + 1, &element
+		);
+		return iterateur_bits( ensemble, trouve, element );
+	}
+	return iterateur_table( iterateur_suivant_table( iterateur.avl ) );
 }
 
 Ensemble_iterateur iterateur_precedent_ensemble( Ensemble_iterateur iterateur ){
-	return iterateur_precedent_table( iterateur );
+	if( iterateur.vide ) return iterateur;
+	if( iterateur.ensemble ){
+		const Ensemble* ensemble = iterateur.ensemble;
+		if( ! est_en_bits( ensemble ) ){
+			Table_iterateur it = trouver_table( ensemble->table, iterateur.element );
+			return iterateur_table( iterateur_precedent_table( it ) );
+		}
+		intptr_t element = 0;
+		int trouve = chercher_bit_precedent(
+			ensemble, iterateur.element - 1, &element
+		);
+		return iterateur_bits( ensemble, trouve, element );
+	}
+	return iterateur_table( iterateur_precedent_table( iterateur.avl ) );
 }
 
 int iterateur_ensemble_est_vide( Ensemble_iterateur iterateur ){
-	return iterateur_est_vide( iterateur );
+	return iterateur.vide;
 }
 
 intptr_t get_element( Ensemble_iterateur it ){
-	return get_cle( it );
+	if( it.ensemble ){
+		return it.element;
+	}
+	return get_cle( it.avl );
 }
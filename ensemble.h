@@ -27,11 +27,28 @@
 #include "avl.h"
 #include "table.h"
 
+/*
+ * Nombre maximal de mots de 64 bits que peut occuper un ensemble codé par un
+ * tableau de bits. Au delà, l'ensemble est codé par une table.
+ */
+#define ENSEMBLE_BITS_MAX_MOTS 4096
+
 /*
  * Définit le type d'un ensemble.
+ *
+ * Un ensemble d'entiers (créé sans fonction de comparaison, de copie ni de
+ * suppression) est codé par un tableau de bits : le bit i du mot k indique
+ * la présence de l'entier 64*(premier_mot+k)+i. Le champ 'table' vaut
+ * alors NULL.
+ * Si un élément ajouté fait dépasser la fenêtre de ENSEMBLE_BITS_MAX_MOTS 
+ * mots, l'ensemble est converti, définitivement, en une table.
+ * Les autres ensembles sont toujours codés par une table.
  */
 struct Ensemble {
 	Table* table;
+	uint64_t* mots;
+	intptr_t premier_mot;
+	size_t nb_mots;
 	int (*comparer_element)( const intptr_t elem1, const intptr_t elem2 );
 	intptr_t (*copier_element)( const intptr_t elem );
 	void (*supprimer_element)(intptr_t elem );
@@ -41,8 +58,17 @@ typedef struct Ensemble Ensemble;
 
 /*
  * Définit le type d'un itérateur sur les éléments d'un ensemble.
+ *
+ * Si l'ensemble est codé par une table, seul le champ 'avl' est utilisé.
+ * Sinon, 'ensemble' pointe sur l'ensemble parcouru et 'element' contient 
+ * l'élément courant ('vide' vaut 1 si l'itérateur est vide).
  */
-typedef struct avl_traverser Ensemble_iterateur;
+typedef struct Ensemble_iterateur {
+	struct avl_traverser avl;
+	const struct Ensemble* ensemble;
+	intptr_t element;
+	int vide;
+} Ensemble_iterateur;
 
 /*
  * Renvoie un nouvel ensemble vide.
@@ -128,6 +154,16 @@ unsigned int taille_ensemble( const Ensemble* ensemble );
  */
 int comparer_ensemble( const Ensemble* ens1, const Ensemble*  ens2 );
 
+/*
+ * Renvoie une valeur de hachage de l'ensemble passé en paramètre.
+ *
+ * Deux ensembles d'entiers égaux (pour comparer_ensemble()) ont la même 
+ * valeur de hachage, quelle que soit leur représentation interne.
+ * Pour les ensembles munis d'une fonction de comparaison, seul le nombre 
+ * d'éléments est pris en compte.
+ */
+uint64_t hacher_ensemble( const Ensemble* ensemble );
+
 /*
  * Renvoie une copie de l'ensemble passé en paramètre
  */
@@ -23,6 +23,12 @@
 
 #include <stdlib.h>
 
+/*
+ * Chaque fil d'exécution compte ses propres allocations : aucune donnée 
+ * n'est partagée entre les fils qui allouent.
+ */
+static _Thread_local size_t nb_allocations = 0;
+
 int test( int result, int ligne ){
 	if( ! result ){
 		printf( "Echec du Test ligne %d.\n", ligne );
@@ -32,6 +38,7 @@ int test( int result, int ligne ){
 }
 
 void* xmalloc( size_t n ){
+	nb_allocations++;
 	void* result = malloc( n );
 	if( ! result ){
 		ERREUR( "Espace insuffisant" );
@@ -39,6 +46,19 @@ void* xmalloc( size_t n ){
 	return result;
 }
 
+void* xrealloc( void* ptr, size_t n ){
+	nb_allocations++;
+	void* result = realloc( ptr, n );
+	if( ! result ){
+		ERREUR( "Espace insuffisant" );
+	}
+	return result;
+}
+
 void xfree( void* ptr ){
 	free(ptr);
 }
+
+size_t nombre_allocations(){
+	return nb_allocations;
+}
@@ -31,8 +31,15 @@
 #define ERREUR(x) do { fprintf(stderr,"ERREUR : %s - ligne : %d, fichier : %s\n", (x), __LINE__, __FILE__ ); exit(EXIT_FAILURE); } while(0)
 
 void* xmalloc( size_t n );
+void* xrealloc( void* ptr, size_t n );
 void xfree( void* ptr );
 
+/*
+ * Renvoie le nombre d'appels à xmalloc() et à xrealloc() faits par le fil
+ * d'exécution appelant depuis son début.
+ */
+size_t nombre_allocations();
+
 #define TEST(y,x) do { x &= (y); if(!(y)){ fprintf(stdout, "\033[31mEchec du test %s() -- ligne : %d, fichier : %s\033[0m\n", __FUNCTION__, __LINE__, __FILE__ ); } } while(0)
 #define TEST1(x) test( x, __LINE__)
 
@@ -21,6 +21,7 @@
 #include "rationnel.h"
 #include "ensemble.h"
 #include "automate.h"
+#include "automate_equivalence.h"
 #include "parse.h"
 #include "scan.h"
 #include "outils.h"
@@ -32,10 +33,22 @@
 
 int yyparse(Rationnel **rationnel, yyscan_t scanner);
 
+static _Thread_local Arene *arene_courante = NULL;
+
+Arene *utiliser_arene(Arene *arene)
+{
+   Arene *precedente = arene_courante;
+   arene_courante = arene;
+   return precedente;
+}
+
 Rationnel *rationnel(Noeud etiquette, char lettre, int position_min, int position_max, void *data, Rationnel *gauche, Rationnel *droit, Rationnel *pere)
 {
    Rationnel *rat;
-   rat = (Rationnel *) malloc(sizeof(Rationnel));
+   if (arene_courante)
+      rat = (Rationnel *) allouer_arene(arene_courante, sizeof(Rationnel));
+   else
+      rat = (Rationnel *) malloc(sizeof(Rationnel));
 
    rat->etiquette = etiquette;
    rat->lettre = lettre;
@@ -302,9 +315,10 @@ int numeroter_rationnel_aux(Rationnel *rat,int i)
          break;
 
       case EPSILON:
-	rat->position_min=0;
-	rat->position_max=0;
-	return 0;
+	/* intervalle vide : le mot vide n'a pas de position */
+	rat->position_min=i+1;
+	rat->position_max=i;
+	return i;
          break;
 
       case UNION:
@@ -379,317 +393,246 @@ bool contient_mot_vide(Rationnel *rat)
 }
 
 /**
- * Cette fonction cherche récursivement les premier 
- * ATTENTION , la valeur renvoyée par la fonction ne correspond
- * pas au résultat mais sert juste à la récursion.
- * Le résultat se retrouve dans Ensemble *e 
+ * Les positions d'une expression numérotée, calculées en un seul parcours
+ * suffixe de l'arbre : pour chaque noeud on calcule une fois s'il est 
+ * effaçable, ses premiers et ses derniers, et on ajoute aux ensembles de 
+ * suivants les arcs créés par les noeuds CONCAT et STAR.
+ * - lettres[p] est la lettre de la position p (1 <= p <= nb_positions) ;
+ * - suivants[p] est l'ensemble suivant(rat, p).
  */
-static bool premierRecursif(Rationnel *rat,Ensemble *e)
+typedef struct {
+  int nb_positions;
+  char *lettres;
+  Ensemble **suivants;
+  Ensemble *premiers;
+  Ensemble *derniers;
+  bool vide;
+} Positions;
+
+static void ajouter_arcs(Positions *pos, const Ensemble *origines, const Ensemble *fins)
 {
-  bool estTrouvePremier=false;
-  /**
-   * Si le premier terme est une lettre on l'ajoute à l'ensemble et
-   * l'on renvoie que le premier a été trouvé
-   */
-  if(rat->etiquette == LETTRE){
-    ajouter_element(e,rat->position_min);
-    return true;
-  }
-  /**
-   * Autrement on cherche récursivement sur le fils gauche le premier.
-   * Si il n'est pas trouvé ou bien que l'étiquette père est une étoile alors
-   * on cherche récursivement sur le fils droit . 
-   */
-  else 
+  Ensemble_iterateur it;
+  for (it = premier_iterateur_ensemble(origines); !iterateur_ensemble_est_vide(it); it = iterateur_suivant_ensemble(it))
+    ajouter_elements(pos->suivants[get_element(it)], fins);
+}
+
+/**
+ * Renvoie vrai si le noeud est effaçable et place dans *premiers et 
+ * *derniers des ensembles alloués, dont l'appelant prend possession.
+ */
+static bool parcourir_positions(Rationnel *rat, Positions *pos, Ensemble **premiers, Ensemble **derniers)
+{
+  Ensemble *pg, *dg, *pd, *dd;
+  bool vg, vd;
+  switch(rat->etiquette)
     {
-      /**
-       * estTrouverPremier peut être faux si l'expression gauche contient une 
-       * étoile avant chaque feuille ou bien si l'expression n'est pas correcte
-       */
-      if(rat->gauche!=NULL)
-	estTrouvePremier=premierRecursif(rat->gauche,e);
-      
-      /**
-       * Dans le cas ou l'expression gauche contient une étoile ou bien 
-       * que l'étiquette courante est une étoile on regarde le fils droit .
-       */
-      if(!estTrouvePremier || rat->etiquette == UNION)
-	if (rat->droit != NULL)
-	  estTrouvePremier=premierRecursif(rat->droit,e);
-      
-      /**
-       * Si l'étiquette courante est une étoile , on renvoie 
-       * que l'élément est encore à chercher . 
-       */
-      if (rat->etiquette == STAR)
-	estTrouvePremier=false;
+    case LETTRE:
+      pos->lettres[rat->position_min] = rat->lettre;
+      *premiers = creer_ensemble(NULL, NULL, NULL);
+      *derniers = creer_ensemble(NULL, NULL, NULL);
+      ajouter_element(*premiers, rat->position_min);
+      ajouter_element(*derniers, rat->position_min);
+      return false;
+
+    case EPSILON:
+      *premiers = creer_ensemble(NULL, NULL, NULL);
+      *derniers = creer_ensemble(NULL, NULL, NULL);
+      return true;
+
+    case UNION:
+      vg = parcourir_positions(rat->gauche, pos, &pg, &dg);
+      vd = parcourir_positions(rat->droit, pos, &pd, &dd);
+      ajouter_elements(pg, pd);
+      ajouter_elements(dg, dd);
+      liberer_ensemble(pd);
+      liberer_ensemble(dd);
+      *premiers = pg;
+      *derniers = dg;
+      return vg || vd;
+
+    case CONCAT:
+      vg = parcourir_positions(rat->gauche, pos, &pg, &dg);
+      vd = parcourir_positions(rat->droit, pos, &pd, &dd);
+      // Une dernière position de gauche est suivie des premières de droite.
+      ajouter_arcs(pos, dg, pd);
+      if (vg)
+        ajouter_elements(pg, pd);
+      if (vd)
+        ajouter_elements(dd, dg);
+      liberer_ensemble(pd);
+      liberer_ensemble(dg);
+      *premiers = pg;
+      *derniers = dd;
+      return vg && vd;
+
+    case STAR:
+      parcourir_positions(rat->gauche, pos, &pg, &dg);
+      // Une dernière position est suivie des premières du même noeud.
+      ajouter_arcs(pos, dg, pg);
+      *premiers = pg;
+      *derniers = dg;
+      return true;
+
+    default:
+      assert(false);
+      return false;
     }
-  return estTrouvePremier;
+}
+
+static Positions *creer_positions(Rationnel *rat)
+{
+  Positions *pos = xmalloc(sizeof(Positions));
+  pos->nb_positions = numeroter_rationnel_aux(rat, 0);
+  pos->lettres = xmalloc(pos->nb_positions + 1);
+  pos->suivants = xmalloc((pos->nb_positions + 1) * sizeof(Ensemble *));
+  for (int i = 0; i <= pos->nb_positions; i++)
+    pos->suivants[i] = creer_ensemble(NULL, NULL, NULL);
+  pos->vide = parcourir_positions(rat, pos, &pos->premiers, &pos->derniers);
+  return pos;
+}
 
+static void liberer_positions(Positions *pos)
+{
+  for (int i = 0; i <= pos->nb_positions; i++)
+    liberer_ensemble(pos->suivants[i]);
+  liberer_ensemble(pos->premiers);
+  liberer_ensemble(pos->derniers);
+  xfree(pos->suivants);
+  xfree(pos->lettres);
+  xfree(pos);
 }
+
 Ensemble *premier(Rationnel *rat)
 {
   /**
    * Attention l'ensemble renvoyé par cette fonction 
    * devra être désalloué (liberer/delivrer_ensemble(Ensemble*))
    */
-  Ensemble *e=creer_ensemble(NULL,NULL,NULL);
-  premierRecursif(rat,e);
+  Positions *pos = creer_positions(rat);
+  Ensemble *e = pos->premiers;
+  pos->premiers = creer_ensemble(NULL, NULL, NULL);
+  liberer_positions(pos);
   return e;
-
-}
-/**
- * Cette fonction fait un parcours préfixe du rationnel pour 
- * rajouté dans l'ensemble e dernier(rat) . La valeur retournée
- * n'a pas d'importance .
- */
-static bool dernierRecursif(Rationnel *rat,Ensemble *e)
-{
-  bool estTrouveDernierDroit=false;
-  bool estTrouveDernierGauche=false;
-  /**
-   * On fait un parcours suffixe
-   */
-  if (rat->droit!=NULL)
-    estTrouveDernierDroit=dernierRecursif(rat->droit,e);
-  /**
-   * Si le noeud droit n'as pas renvoyer vrai (effacable) ou bien que le noeud courant 
-   * est + ou * alors on regarde le fils gauche puisque le fils droit est effaçable
-   */
-  if (!estTrouveDernierDroit||rat->etiquette==UNION || rat->etiquette == STAR)
-    {
-      if(rat->gauche!=NULL)
-	estTrouveDernierGauche=dernierRecursif(rat->gauche,e);
-    }
-  /**
-   * Quoique puisse renvoyer les fils d'une étoile il resteront effaçable.
-   */
-  if(rat->etiquette==STAR){
-    estTrouveDernierDroit=false;
-
-  }
-  /**
-   * Si on est sur une feuille alors on rajoute l'élément à la liste des dernier
-   * et on renvoie non effaçable (valeur qui pourra changer en remontant dans l'arbre).
-   */
-  if (estTrouveDernierDroit==false&&rat->etiquette==LETTRE){
-    ajouter_element(e,rat->position_min);
-    estTrouveDernierDroit=true;
-  }
-  /**
-   * Un + n'est pas effaçable si 
-   * son fils droit et son fils gauche ne sont pas effaçable.
-   */
-  if(rat->etiquette == UNION){
-    return estTrouveDernierDroit && estTrouveDernierGauche;
-  }
-  return estTrouveDernierDroit;
 }
 
 Ensemble *dernier(Rationnel *rat)
 {
-  Ensemble *e=creer_ensemble(NULL,NULL,NULL);
-  dernierRecursif(rat,e);
+  Positions *pos = creer_positions(rat);
+  Ensemble *e = pos->derniers;
+  pos->derniers = creer_ensemble(NULL, NULL, NULL);
+  liberer_positions(pos);
   return e;
 }
-void suivantRecursif(Rationnel *rat,Ensemble *e,int p)
-{
-   switch(rat->etiquette)
-   {
-      case LETTRE:
-         break;
-
-      case EPSILON:	
-         break;
-
-      case UNION:
-	suivantRecursif(rat->gauche,e,p);
-	suivantRecursif(rat->droit,e,p);
-	break;
 
-      case CONCAT:
-	if(est_dans_l_ensemble(dernier(rat->gauche),p))
-	  {
-	  ajouter_elements(e,premier((rat->droit)));
-	  suivantRecursif(rat->gauche,e,p);
-	  break;
-	  }
-	if(p<=rat->gauche->position_max)
-	  suivantRecursif(rat->gauche,e,p);
-	else 
-	  suivantRecursif(rat->droit,e,p);
-        break;
-
-      case STAR:
-	if (p<=rat->position_max || p>=rat->position_min)
-	  {
-	    if(est_dans_l_ensemble(dernier(rat->gauche),p))
-	      ajouter_elements(e,premier((rat->gauche)));
-	    else
-	      suivantRecursif(rat->gauche,e,p);
-	  }
-        break;
-         
-      default:
-         assert(false);
-         break;
-   }
-}
 Ensemble *suivant(Rationnel *rat, int position)
-{// XXX test pas passé
-  Ensemble *e=creer_ensemble(NULL,NULL,NULL);
-  suivantRecursif(rat,e,position);
+{
+  Positions *pos = creer_positions(rat);
+  Ensemble *e;
+  if (position >= 1 && position <= pos->nb_positions)
+    {
+      e = pos->suivants[position];
+      pos->suivants[position] = creer_ensemble(NULL, NULL, NULL);
+    }
+  else
+    e = creer_ensemble(NULL, NULL, NULL);
+  liberer_positions(pos);
   return e;
 }
 
-Rationnel *getRatFromPos(Rationnel *rat,int p){
-  Rationnel *retour=NULL;
-  if(rat->droit != NULL)
-    if((retour=getRatFromPos(rat->droit,p))!=NULL)
-      return retour;
-  if(rat->gauche != NULL)
-    if((retour=getRatFromPos(rat->gauche,p))!=NULL)
-      return retour;  
-  if (rat->etiquette == LETTRE && rat->position_min ==p)
-    return rat;
-  return retour;
-}
-
 Automate *Glushkov(Rationnel *rat)
 {
-  /* on numérote le rationnel puis on le transforme 
-     en automate de glushkov*/
-  numeroter_rationnel(rat);
+  /* on numérote le rationnel et on calcule en un seul parcours
+     les premiers, derniers et suivants de toutes les positions */
+  Positions *pos = creer_positions(rat);
   Automate *ret=creer_automate();
+  Ensemble_iterateur it;
 
   //init
   ajouter_etat_initial(ret,0);
-  Ensemble_iterateur it1;
+  if (pos->vide)
+    ajouter_etat_final(ret, 0);
+  for (int i = 1; i <= pos->nb_positions; i++)
+    ajouter_etat(ret, i);
 
   //premiers
-  Ensemble* p= premier(rat);
-  if (contient_mot_vide(rat)) 
-      ajouter_etat_final(ret, 0);
-   
-
-  for (it1 = premier_iterateur_ensemble(p); !iterateur_est_vide(it1); it1 = iterateur_suivant_ensemble(it1)) {
-    ajouter_etat(ret, get_element(it1));
-    ajouter_transition(ret, 0, getRatFromPos(rat, get_element(it1))->lettre, get_element(it1));
-   }
+  for (it = premier_iterateur_ensemble(pos->premiers); !iterateur_ensemble_est_vide(it); it = iterateur_suivant_ensemble(it))
+    ajouter_transition(ret, 0, pos->lettres[get_element(it)], get_element(it));
 
   //suivants
-  for (int i = 1; i <=rat->position_max ; i++) {
-    Ensemble* s=suivant(rat, i);
+  for (int i = 1; i <= pos->nb_positions; i++)
+    for (it = premier_iterateur_ensemble(pos->suivants[i]); !iterateur_ensemble_est_vide(it); it = iterateur_suivant_ensemble(it))
+      ajouter_transition(ret, i, pos->lettres[get_element(it)], get_element(it));
 
-    for (it1 = premier_iterateur_ensemble(s); !iterateur_est_vide(it1); it1 = iterateur_suivant_ensemble(it1)) {
-      ajouter_etat(ret, i);
-      ajouter_transition(ret, i, getRatFromPos(rat, get_element(it1))->lettre, get_element(it1));
-    }
-    liberer_ensemble(s);
-  }
+  // finaux
+  for (it = premier_iterateur_ensemble(pos->derniers); !iterateur_ensemble_est_vide(it); it = iterateur_suivant_ensemble(it))
+    ajouter_etat_final(ret, get_element(it));
 
-   // finaux
-   Ensemble* d= dernier(rat);
+  liberer_positions(pos);
 
-   for (it1 = premier_iterateur_ensemble(d); !iterateur_est_vide(it1); it1 = iterateur_suivant_ensemble(it1)) {
-      ajouter_etat_final(ret, get_element(it1));
-   }
-   liberer_ensemble(p);
-   liberer_ensemble(d);
-   return ret;
+  // Les automates de Glushkov sont homogènes : on peut les simuler bit à
+  // bit. La simulation n'est construite qu'à la première lecture d'un mot.
+  ret->simulable = 1;
+  return ret;
 }
 /*static void print_elt(const intptr_t cle)
 {
   printf("cle : %"PRIxPTR "\n",cle);
   }*/
-static Automate *complementaire(const Automate *automate)
+// Les automates de Glushkov de deux expressions, dont les arbres sont
+// alloués dans une arène temporaire.
+static void glushkov_des_expressions(const char *expr1, const char* expr2,
+				     Automate **a1, Automate **a2)
 {
-  Automate * res = creer_automate();
-  
-  Ensemble_iterateur it1;
-  // On ajoute les états de l'automate
-  for(
-      it1 = premier_iterateur_ensemble( get_etats( automate )
-);
-      ! iterateur_ensemble_est_vide( it1 );
-      it1 = iterateur_suivant_ensemble( it1 )
-      ){
-    ajouter_etat(res, get_element( it1 ) );
-    if (!est_dans_l_ensemble(get_finaux(automate),get_element(it1)))
-      ajouter_etat_final(res,get_element(it1));
-    
-  }
-  // On ajoute les états initiaux
-  for(
-      it1 = premier_iterateur_ensemble( get_initiaux( automate ) );
-      ! iterateur_ensemble_est_vide( it1 );
-      it1 = iterateur_suivant_ensemble( it1 )
-      ){
-    ajouter_etat_initial( res, get_element( it1 ) );
-  }
-  
-  // On ajoute les lettres
-  for(
-      it1 = premier_iterateur_ensemble( get_alphabet( automate ) );
-      ! iterateur_ensemble_est_vide( it1 );
-      it1 = iterateur_suivant_ensemble( it1 )
-      ){
-    ajouter_lettre( res, (char) get_element( it1 ) );
-  }
-  // On ajoute les transitions
-  Table_iterateur it2;
-  for(
-      it2 = premier_iterateur_table( automate->transitions );
-      ! iterateur_est_vide( it2 );
-      it2 = iterateur_suivant_table( it2 )
-      ){
-    Cle * cle = (Cle*) get_cle( it2 );
-    Ensemble * fins = (Ensemble*) get_valeur( it2 );
-    for(
-	it1 = premier_iterateur_ensemble( fins );
-	! iterateur_ensemble_est_vide( it1 );
-	it1 = iterateur_suivant_ensemble( it1 )
-	){
-      int fin = get_element( it1 );
-      ajouter_transition( res, cle->origine, cle->lettre, fin );
-    }
-  }
-  return res;
+  Arene *arene=creer_arene();
+  Arene *precedente=utiliser_arene(arene);
+  Rationnel *r1=expression_to_rationnel(expr1);
+  Rationnel *r2=expression_to_rationnel(expr2);
   
+  *a1=Glushkov(r1);
+  *a2=Glushkov(r2);
+  utiliser_arene(precedente);
+  liberer_arene(arene);
 }
 
 bool meme_langage (const char *expr1, const char* expr2)
 { 
-  Rationnel *r1=expression_to_rationnel(expr1);
-  Rationnel *r2=expression_to_rationnel(expr2);
-  
-  Automate *a1=Glushkov(r1);
-  Automate *a2=Glushkov(r2);
-  
-  const Automate *m1=creer_automate_minimal(a1);
-  const Automate *m2=creer_automate_minimal(a2);
+  Automate *a1, *a2;
+  glushkov_des_expressions(expr1,expr2,&a1,&a2);
+
+  // Pas de minimisation ni de complémentaire : les deux automates sont
+  // comparés directement (voir automates_equivalents()).
+  bool res=automates_equivalents(a1,a2,NULL);
+  liberer_automate(a1);
+  liberer_automate(a2);
+  return res;
+}
 
-  Automate *m1bar=complementaire(m1);
-  Automate *m2bar=complementaire(m2);
+bool meme_langage_contre_exemple (const char *expr1, const char* expr2,
+				  char **contre_exemple)
+{
+  Automate *a1, *a2;
+  glushkov_des_expressions(expr1,expr2,&a1,&a2);
 
-  Automate *inter1=creer_intersection_des_automates(m1bar,m2);
-  Automate *inter2=creer_intersection_des_automates(m2bar,m1);
-  
-  Automate *acces1=automate_accessible(inter1);
-  Automate *acces2=automate_accessible(inter2);
+  char *mot=mot_distinguant(a1,a2);
+  liberer_automate(a1);
+  liberer_automate(a2);
+  bool res=mot==NULL;
+  if(contre_exemple)
+    *contre_exemple=mot;
+  else
+    xfree(mot);
+  return res;
+}
 
-  //print_ensemble(get_finaux(acces1),&print_elt);
-  // print_ensemble(get_finaux(acces2),&print_elt);
-  
-  int res=((taille_ensemble(get_finaux(acces1))==0)&&(taille_ensemble(get_finaux(acces2))==0));
+bool langage_inclus (const char *expr1, const char* expr2,
+		     char **contre_exemple)
+{
+  Automate *a1, *a2;
+  glushkov_des_expressions(expr1,expr2,&a1,&a2);
+
+  bool res=automate_est_inclus(a1,a2,contre_exemple);
   liberer_automate(a1);
   liberer_automate(a2);
-  liberer_automate(m1bar);
-  liberer_automate(m2bar);
-  liberer_automate(inter1);
-  liberer_automate(inter2);
-  liberer_automate(acces1);
-  liberer_automate(acces2);
   return res;
 }
 
@@ -820,7 +763,7 @@ Systeme resoudre_systeme(Systeme systeme, int n)
       int j=0;
       for(;j<n;++j)
 	{
-	  resoudre_variable_arden(systeme[j],j,n+1); 
+	  resoudre_variable_arden(systeme[j],j,n);
 	}
       int k=0;
       for(;k<n;++k)
@@ -841,7 +784,12 @@ Rationnel *Arden(Automate *automate)
   Systeme systemed=systeme(automate);
   int nbLigne=taille_ensemble(get_etats(automate));
   resoudre_systeme(systemed,nbLigne);
-  return systemed[0][nbLigne];
-  return NULL;
+  Rationnel *res=systemed[0][nbLigne];
+  /* les noeuds appartiennent à l'arène courante : on ne libère que 
+     les lignes du système */
+  for (int i = 0; i < nbLigne; i++)
+    free(systemed[i]);
+  free(systemed);
+  return res;
 }
 
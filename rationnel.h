@@ -26,6 +26,7 @@
 #include <stdio.h>
 #include "automate.h"
 #include "ensemble.h"
+#include "arene.h"
 
 /**
  * @brief Type d'expression.
@@ -154,6 +155,24 @@ Rationnel *Concat(Rationnel* rat1, Rationnel* rat2);
  */   
 Rationnel *Star(Rationnel* rat);
 
+/**
+ * @brief Choisit l'arène dans laquelle sont alloués les rationnels.
+ *
+ * Tant qu'une arène est utilisée, tous les noeuds créés par rationnel(),
+ * et donc par Epsilon(), Lettre(), Union(), Concat(), Star(), 
+ * expression_to_rationnel() et Arden(), sont alloués les uns à la suite 
+ * des autres dans cette arène. Ils sont tous libérés par liberer_arene(), 
+ * ce qui permet de libérer des expressions qui partagent des 
+ * sous-expressions. Si l'arène est NULL, chaque noeud est alloué avec 
+ * malloc() et n'est jamais libéré.
+ *
+ * L'arène utilisée est propre à chaque thread.
+ *
+ * @param arene L'arène à utiliser, ou NULL.
+ * @return L'arène utilisée jusque-là, à rétablir une fois le travail fini.
+ */
+Arene *utiliser_arene(Arene *arene);
+
 /**
  * @brief Teste si un pointeur sur un rationnel représente la racine.
  * @param rat Pointeur sur le rationnel à tester.
@@ -320,8 +339,10 @@ Ensemble *suivant(Rationnel *, int);
 Automate *Glushkov(Rationnel *rat);
 
 /**
- * @brief @todo
- * Teste si deux expressions reconnaissent le même langage.
+ * @brief Teste si deux expressions reconnaissent le même langage.
+ *
+ * Les automates de Glushkov des deux expressions sont comparés par 
+ * automates_equivalents(), sans être minimisés.
  *
  * @param expr1 La première expression.
  * @param expr2 La deuxième expression.
@@ -329,6 +350,39 @@ Automate *Glushkov(Rationnel *rat);
  */
 bool meme_langage (const char *expr1, const char* expr2);
 
+/**
+ * @brief Teste si deux expressions reconnaissent le même langage et, 
+ *        sinon, donne un plus court mot qui les distingue.
+ *
+ * Voir mot_distinguant().
+ *
+ * @param expr1 La première expression.
+ * @param expr2 La deuxième expression.
+ * @param contre_exemple Si ce pointeur est non NULL, il reçoit un plus 
+ *        court mot reconnu par une seule des expressions (à libérer avec 
+ *        xfree()), ou NULL si les langages sont égaux.
+ * @result true ou false.
+ */
+bool meme_langage_contre_exemple (const char *expr1, const char* expr2,
+				  char **contre_exemple);
+
+/**
+ * @brief Teste si le langage de la première expression est inclus dans
+ *        celui de la deuxième.
+ *
+ * Voir automate_est_inclus().
+ *
+ * @param expr1 La première expression.
+ * @param expr2 La deuxième expression.
+ * @param contre_exemple Si ce pointeur est non NULL et que le langage 
+ *        n'est pas inclus, il reçoit un plus court mot reconnu par la 
+ *        première expression et pas par la deuxième, à libérer avec 
+ *        xfree().
+ * @result true ou false.
+ */
+bool langage_inclus (const char *expr1, const char* expr2,
+		     char **contre_exemple);
+
 /**
  * @brief @todo Construit le système d'équations de langages associé à un automate. Voir @ref Systeme pour la représentation de ce système.
  * @param automate L'automate à transformer en système, en supposant ses états
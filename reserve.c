@@ -0,0 +1,117 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux.
+ *
+ *   Copyright (C) 2014 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "reserve.h"
+#include "outils.h"
+
+#include <assert.h>
+#include <stdatomic.h>
+
+static atomic_int reserves_directes = 0;
+
+/*
+ * Nombre d'objets du premier bloc. Chaque nouveau bloc est deux fois plus
+ * grand que le précédent, jusqu'à OBJETS_PAR_BLOC_MAX objets.
+ */
+#define OBJETS_PAR_BLOC_MIN 16
+#define OBJETS_PAR_BLOC_MAX 4096
+
+/*
+ * Un bloc commence par un pointeur vers le bloc précédent, suivi des 
+ * objets. Un objet libre commence par un pointeur vers l'objet libre 
+ * suivant.
+ */
+typedef union {
+	void * suivant;
+	max_align_t alignement;
+} Entete;
+
+static void* allouer_avl( struct libavl_allocator* allocateur, size_t taille ){
+	Reserve* reserve = (Reserve*) allocateur;
+	assert( taille <= reserve->taille_objet );
+	return allouer_reserve( reserve );
+}
+
+static void liberer_avl( struct libavl_allocator* allocateur, void* objet ){
+	restituer_reserve( (Reserve*) allocateur, objet );
+}
+
+void utiliser_reserves_directes( int directe ){
+	atomic_store( &reserves_directes, directe );
+}
+
+void initialiser_reserve( Reserve* reserve, size_t taille_objet ){
+	reserve->directe = atomic_load( &reserves_directes );
+	reserve->allocateur.libavl_malloc = allouer_avl;
+	reserve->allocateur.libavl_free = liberer_avl;
+	if( taille_objet < sizeof(Entete) ) taille_objet = sizeof(Entete);
+	reserve->taille_objet = 
+		( taille_objet + sizeof(Entete) - 1 ) / sizeof(Entete) * sizeof(Entete);
+	reserve->objets_par_bloc = OBJETS_PAR_BLOC_MIN;
+	reserve->libres = NULL;
+	reserve->blocs = NULL;
+}
+
+void detruire_reserve( Reserve* reserve ){
+	Entete* bloc = reserve->blocs;
+	while( bloc ){
+		Entete* precedent = bloc->suivant;
+		xfree( bloc );
+		bloc = precedent;
+	}
+	reserve->blocs = NULL;
+	reserve->libres = NULL;
+}
+
+void* allouer_reserve( Reserve* reserve ){
+	if( reserve->directe ){
+		return xmalloc( reserve->taille_objet );
+	}
+	if( ! reserve->libres ){
+		size_t n = reserve->objets_par_bloc;
+		Entete* bloc = xmalloc( sizeof(Entete) + n * reserve->taille_objet );
+		bloc->suivant = reserve->blocs;
+		reserve->blocs = bloc;
+		// Les objets du nouveau bloc sont chaînés dans la liste des libres.
+		char* objet = (char*) ( bloc + 1 );
+		size_t i;
+		for( i = 0; i < n; i++ ){
+			( (Entete*) objet )->suivant = 
+				i + 1 < n ? objet + reserve->taille_objet : NULL;
+			objet += reserve->taille_objet;
+		}
+		reserve->libres = bloc + 1;
+		if( reserve->objets_par_bloc < OBJETS_PAR_BLOC_MAX ){
+			reserve->objets_par_bloc *= 2;
+		}
+	}
+	Entete* res = reserve->libres;
+	reserve->libres = res->suivant;
+	return res;
+}
+
+void restituer_reserve( Reserve* reserve, void* objet ){
+	if( reserve->directe ){
+		xfree( objet );
+		return;
+	}
+	( (Entete*) objet )->suivant = reserve->libres;
+	reserve->libres = objet;
+}
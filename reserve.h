@@ -0,0 +1,83 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux.
+ *
+ *   Copyright (C) 2014 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __RESERVE_H__
+#define __RESERVE_H__
+
+#include <stddef.h>
+#include "avl.h"
+
+/*
+ * Définit le type d'une réserve : un allocateur d'objets qui ont tous la 
+ * même taille. Les objets sont découpés dans de grands blocs et les 
+ * objets libérés sont gardés dans une liste pour être réutilisés. Les 
+ * blocs ne sont rendus au système qu'à la destruction de la réserve.
+ *
+ * Le champ 'allocateur' permet de brancher la réserve sur un arbre AVL 
+ * (voir avl_create()) : toutes les allocations de l'arbre, qui doivent
+ * faire au plus 'taille_objet' octets, sont alors faites dans la réserve.
+ */
+typedef struct Reserve {
+	struct libavl_allocator allocateur;
+	size_t taille_objet;
+	size_t objets_par_bloc;
+	void * libres;
+	void * blocs;
+	int directe;
+} Reserve;
+
+/*
+ * Réservé aux mesures (benchs/bench_determinisation.c et 
+ * tests/test_table.c) : le reste de la bibliothèque ne doit jamais 
+ * l'appeler.
+ *
+ * Si 'directe' vaut 1, les réserves initialisées ensuite ne découpent plus
+ * de blocs : chaque objet est alloué par xmalloc() et rendu par xfree().
+ * Le réglage est global au processus et n'est lu qu'à l'initialisation 
+ * d'une réserve ; il ne faut donc pas le changer pendant que d'autres fils
+ * d'exécution créent des tables.
+ *
+ * Ce mode ne reproduit pas les tables d'avant les réserves : seuls les 
+ * noeuds de l'arbre AVL repassent par xmalloc(), les clés restent copiées
+ * une seule fois par insertion et les recherches n'allouent toujours rien.
+ */
+void utiliser_reserves_directes( int directe );
+
+/*
+ * Initialise une réserve vide d'objets de 'taille_objet' octets.
+ */
+void initialiser_reserve( Reserve* reserve, size_t taille_objet );
+
+/*
+ * Rend au système la mémoire de tous les objets de la réserve.
+ */
+void detruire_reserve( Reserve* reserve );
+
+/*
+ * Renvoie un objet de la réserve.
+ */
+void* allouer_reserve( Reserve* reserve );
+
+/*
+ * Remet un objet dans la réserve.
+ */
+void restituer_reserve( Reserve* reserve, void* objet );
+
+#endif
@@ -22,25 +22,40 @@
 #include "outils.h"
 #include "fifo.h"
 #include "avl.h"
+#include "reserve.h"
 
 #include <assert.h>
 
 #include <search.h>
+#include <stddef.h>
 #include <stdlib.h>
 
 typedef struct Table_association {
-	void (*supprimer_cle)(intptr_t cle);
-	intptr_t (*copier_cle)(const intptr_t cle);
-	int (*comparer_cle)(const intptr_t cle1, const intptr_t cle2);
 	intptr_t cle;
 	intptr_t valeur;
 } Table_association ;
 
+/*
+ * Un noeud de l'arbre AVL et l'association qu'il contient sont alloués 
+ * ensemble, dans la réserve de la table : le champ avl_data du noeud 
+ * pointe sur le champ association du même noeud.
+ */
+typedef struct Noeud_table {
+	struct avl_node noeud;
+	Table_association association;
+} Noeud_table;
+
+#define TAILLE_OBJET_TABLE ( \
+	sizeof(Noeud_table) > sizeof(struct avl_table) ? \
+	sizeof(Noeud_table) : sizeof(struct avl_table) \
+)
+
 struct Table {
 	int (*comparer_cle)( const intptr_t cle1, const intptr_t cle2 );
 	intptr_t (*copier_cle)( const intptr_t cle );
 	void (*supprimer_cle)(intptr_t cle);
 	struct avl_table * root;
+	Reserve reserve;
 };
 
 
@@ -54,41 +69,12 @@ intptr_t get_valeur( Table_iterateur it ){
 	return asso->valeur;
 }
 
-Table_association * creer_table_association(
-	const Table* table, const intptr_t cle, intptr_t valeur
-){
-	Table_association * res = xmalloc(
-		sizeof( Table_association )
-	);
-	if( table->copier_cle && cle ){
-		res->cle = table->copier_cle( cle );
-	}else{
-		res->cle = cle;
-	}
-	res->valeur = valeur;
-	res->supprimer_cle = table->supprimer_cle;
-	res->copier_cle = table->copier_cle;
-	res->comparer_cle = table->comparer_cle;
-	return res;
-}
-
-Table_association * copier_table_association( Table_association * asso ){
-	Table_association * res = xmalloc(
-		sizeof( Table_association )
-	);
-	*res = *asso;
-	if( asso->copier_cle && asso->cle ){
-		res->cle = asso->copier_cle( asso->cle );
-	}
-	return res;
-}
-
 int compare_table_association( const void * pa1, const void * pb1, void* param ){
-	Table_association * pa = (Table_association *) pa1;
-	Table_association * pb = (Table_association *) pb1;
-	if( pa->comparer_cle ){
-		int r = pa->comparer_cle( pa->cle, pb->cle );
-		return r;
+	const Table * table = (const Table *) param;
+	const Table_association * pa = (const Table_association *) pa1;
+	const Table_association * pb = (const Table_association *) pb1;
+	if( table->comparer_cle ){
+		return table->comparer_cle( pa->cle, pb->cle );
 	}else{
 		if( pa->cle < pb->cle )
 			return -1;
@@ -98,20 +84,18 @@ int compare_table_association( const void * pa1, const void * pb1, void* param )
 	}
 }
 
-
 void supprimer_table_association2( void* asso_tmp, void* data ){
 	Table_association * asso = (Table_association*) asso_tmp;
-	if( asso->supprimer_cle && asso->cle ){
-		asso->supprimer_cle( asso->cle );
+	Table * table = (Table*) data;
+	if( table->supprimer_cle && asso->cle ){
+		table->supprimer_cle( asso->cle );
 	}
-	xfree(asso);
 }
 
-void supprimer_table_association( Table_association * asso ){
-	if( asso->supprimer_cle && asso->cle ){
-		asso->supprimer_cle( asso->cle );
-	}
-	xfree(asso);
+static struct avl_table * creer_arbre( Table* table ){
+	return avl_create( 
+		compare_table_association, table, &table->reserve.allocateur 
+	);
 }
 
 Table* creer_table(
@@ -120,49 +104,59 @@ Table* creer_table(
 	void (*supprimer_cle)(intptr_t cle)
 ){
 	Table* res = xmalloc( sizeof(Table) );
-	res->root = avl_create ( compare_table_association, NULL, NULL );
-
 	res->supprimer_cle = supprimer_cle;
 	res->comparer_cle = comparer_cle;
 	res->copier_cle = copier_cle;
+	initialiser_reserve( &res->reserve, TAILLE_OBJET_TABLE );
+	res->root = creer_arbre( res );
 	return res;
 }
 
 void liberer_table( Table* table ){
 	assert( table );
 	avl_destroy ( table->root, supprimer_table_association2 );
+	detruire_reserve( &table->reserve );
 	xfree( table );
 }
 
 void add_table( Table* table, const intptr_t cle, intptr_t valeur ) {
-	Table_association* asso = creer_table_association(table, cle, valeur);
-	void* val = avl_probe ( table->root, (void*) asso );
+	Table_association asso;
+	asso.cle = cle;
+	asso.valeur = valeur;
+	void** val = avl_probe ( table->root, (void*) &asso );
 	if( val == NULL ){
 		ERREUR( "Espace insuffisant" );
 	}
-	Table_association* asso_tree = *( Table_association** ) val; 
-	if( asso_tree != asso  ){
-		supprimer_table_association( asso );
-		asso_tree->valeur = valeur;
+	if( *val == &asso ){
+		// Nouveau noeud : on recopie l'association dans le noeud.
+		Noeud_table* noeud = (Noeud_table*) (
+			(char*) val - offsetof( Noeud_table, noeud.avl_data )
+		);
+		if( table->copier_cle && cle ){
+			noeud->association.cle = table->copier_cle( cle );
+		}else{
+			noeud->association.cle = cle;
+		}
+		noeud->association.valeur = valeur;
+		*val = &noeud->association;
+	}else{
+		( (Table_association*) *val )->valeur = valeur;
 	}
 }
 
 intptr_t delete_table( Table* table, intptr_t cle ){
-	intptr_t valeur = (intptr_t) NULL;
-	Table_association* asso_tree = NULL;
-	Table_association* asso = creer_table_association(
-		table, cle, (intptr_t) NULL
-	);
-	void* val = avl_find( table->root, (void*) asso );
-	if( val ){
-		asso_tree = ( Table_association* ) val; 
-		valeur = asso_tree->valeur;
+	Table_association asso;
+	asso.cle = cle;
+	Table_association* asso_tree = avl_find( table->root, (void*) &asso );
+	if( ! asso_tree ){
+		return (intptr_t) NULL;
 	}
-	avl_delete( table->root, (void*) asso );
-	if(asso_tree){
-		supprimer_table_association( asso_tree );
+	intptr_t valeur = asso_tree->valeur;
+	intptr_t cle_tree = asso_tree->cle;
+	avl_delete( table->root, (void*) &asso );
+	if( table->supprimer_cle && cle_tree ){
+		table->supprimer_cle( cle_tree );
 	}
-	supprimer_table_association( asso );
 	return valeur;
 }
 
@@ -200,7 +194,7 @@ void pour_toute_valeur_table(
 
 void vider_table( Table* table ){
 	avl_destroy ( table->root, supprimer_table_association2 );
-	table->root = avl_create ( compare_table_association, NULL, NULL );
+	table->root = creer_arbre( table );
 }
 
 typedef struct {
@@ -240,11 +234,9 @@ void print_table(
 
 Table_iterateur trouver_table( const Table* table, intptr_t cle ){
 	Table_iterateur it;
-	Table_association* asso = creer_table_association(
-		table, cle, (intptr_t) NULL
-	);
-	avl_t_find( &it, table->root, (void*) asso );
-	supprimer_table_association( asso );
+	Table_association asso;
+	asso.cle = cle;
+	avl_t_find( &it, table->root, (void*) &asso );
 	return it;
 }
 
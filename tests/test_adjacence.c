@@ -0,0 +1,177 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "automate.h"
+#include "outils.h"
+
+#include <pthread.h>
+
+#define NB_FILS 8
+
+typedef struct Demandeur {
+	const Automate* automate;
+	const Adjacence* adjacence;
+	const Adjacence* inverse;
+	pthread_t id;
+} Demandeur;
+
+static void* demander( void* argument ){
+	Demandeur* demandeur = argument;
+	demandeur->adjacence = adjacence_automate( demandeur->automate );
+	demandeur->inverse = adjacence_inverse_automate( demandeur->automate );
+	return NULL;
+}
+
+int test_adjacence(){
+	int result = 1;
+
+	{
+		Automate * automate = creer_automate();
+		ajouter_transition( automate, 10, 'b', 30 );
+		ajouter_transition( automate, 10, 'a', 20 );
+		ajouter_transition( automate, 10, 'a', 30 );
+		ajouter_transition( automate, 30, 'a', 10 );
+		ajouter_etat( automate, 40 );
+
+		const Adjacence * adj = adjacence_automate( automate );
+		const Adjacence * inv = adjacence_inverse_automate( automate );
+		int meme_index = adj == adjacence_automate( automate );
+
+		int n10 = numero_etat( adj, 10 );
+		int n30 = numero_etat( adj, 30 );
+		TEST(
+			1
+			&& meme_index
+			&& adj->nb_etats == 4
+			&& adj->nb_transitions == 4
+			&& numero_etat( adj, 40 ) == 3
+			&& numero_etat( adj, 15 ) == -1
+			&& adj->debut[n10+1] - adj->debut[n10] == 3
+			&& adj->lettres[ adj->debut[n10] ] == 'a'
+			&& adj->etats[ adj->voisins[ adj->debut[n10] ] ] == 20
+			&& adj->lettres[ adj->debut[n10] + 2 ] == 'b'
+			&& inv->debut[n30+1] - inv->debut[n30] == 2
+			&& inv->etats[ inv->voisins[ inv->debut[n30] ] ] == 10
+			&& inv->debut[n10+1] - inv->debut[n10] == 1
+			&& inv->debut[4] == inv->debut[3]
+			, result
+		);
+
+		// Toute modification détruit les index.
+		ajouter_transition( automate, 40, 'a', 40 );
+		adj = adjacence_automate( automate );
+		inv = adjacence_inverse_automate( automate );
+		TEST(
+			1
+			&& adj->nb_transitions == 5
+			&& adj->debut[4] - adj->debut[3] == 1
+			&& inv->debut[4] - inv->debut[3] == 1
+			, result
+		);
+		liberer_automate( automate );
+	}
+
+	{
+		// Le miroir, le produit et l'accessibilité utilisent les index.
+		Automate * automate = creer_automate();
+		int i;
+		for( i = 0; i < 100; i++ ){
+			ajouter_transition( automate, i, 'a', ( i + 1 ) % 100 );
+			ajouter_transition( automate, i, 'b', i );
+		}
+		ajouter_etat_initial( automate, 0 );
+		ajouter_etat_final( automate, 99 );
+		Automate * inverse = miroir( automate );
+		Automate * produit = creer_intersection_des_automates( automate, inverse );
+		Ensemble * access = accessibles( inverse );
+		char mot[101];
+		for( i = 0; i < 99; i++ ) mot[i] = 'a';
+		mot[99] = 'b';
+		mot[100] = '\0';
+
+		TEST(
+			1
+			&& nombre_de_transitions( inverse ) == 200
+			&& est_une_transition_de_l_automate( inverse, 1, 'a', 0 )
+			&& est_un_etat_initial_de_l_automate( inverse, 99 )
+			&& le_mot_est_reconnu( inverse, mot )
+			&& ! le_mot_est_reconnu( inverse, mot + 1 )
+			&& taille_ensemble( access ) == 100
+			&& taille_ensemble( get_etats( produit ) ) == 100
+			&& ! le_mot_est_reconnu( produit, "a" )
+			, result
+		);
+		liberer_ensemble( access );
+		liberer_automate( produit );
+		liberer_automate( inverse );
+		liberer_automate( automate );
+	}
+
+	{
+		// Des fils qui demandent les index en même temps reçoivent tous 
+		// le même index.
+		Automate * automate = creer_automate();
+		int i, tour;
+		for( i = 0; i < 1000; i++ ){
+			ajouter_transition( automate, i, 'a', ( i + 1 ) % 1000 );
+			ajouter_transition( automate, i, 'b', ( i * 7 ) % 1000 );
+		}
+		int memes_index = 1;
+		for( tour = 0; tour < 10; tour++ ){
+			Demandeur demandeurs[NB_FILS];
+			for( i = 0; i < NB_FILS; i++ ){
+				demandeurs[i].automate = automate;
+				if( 
+					pthread_create( 
+						&demandeurs[i].id, NULL, demander, &demandeurs[i] 
+					)
+				){
+					ERREUR( "Impossible de créer un fil d'exécution" );
+				}
+			}
+			for( i = 0; i < NB_FILS; i++ ){
+				pthread_join( demandeurs[i].id, NULL );
+			}
+			for( i = 0; i < NB_FILS; i++ ){
+				memes_index = memes_index
+					&& demandeurs[i].adjacence == adjacence_automate( automate )
+					&& demandeurs[i].inverse == 
+						adjacence_inverse_automate( automate )
+					&& demandeurs[i].adjacence->nb_transitions == 2000;
+			}
+			ajouter_etat( automate, 1000 + tour );
+		}
+		TEST(
+			1
+			&& memes_index
+			, result
+		);
+		liberer_automate( automate );
+	}
+
+	return result;
+}
+
+int main(){
+
+	if( ! test_adjacence() ){ return 1; }
+
+	return 0;
+}
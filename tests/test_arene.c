@@ -0,0 +1,120 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "arene.h"
+#include "rationnel.h"
+#include "outils.h"
+
+#include <stdint.h>
+
+int test_arene(){
+	int result = 1;
+
+	{
+		Arene * arene = creer_arene();
+		int i, alignes = 1;
+		char * precedent = NULL;
+		int contigus = 1;
+		for( i = 0; i < 100000; i++ ){
+			char * p = allouer_arene( arene, 24 );
+			alignes &= ( (uintptr_t) p % _Alignof( max_align_t ) ) == 0;
+			p[23] = 1;
+			if( precedent && i < 100 ){
+				contigus &= p - precedent == 32;
+			}
+			precedent = p;
+		}
+		char * gros = allouer_arene( arene, 10000000 );
+		gros[10000000 - 1] = 1;
+
+		TEST(
+			1
+			&& alignes
+			&& contigus
+			&& taille_arene( arene ) == 100000 * 32 + 10000000
+			, result
+		);
+		liberer_arene( arene );
+	}
+
+	{
+		Arene * arene = creer_arene();
+		Arene * precedente = utiliser_arene( arene );
+		Rationnel * rat = expression_to_rationnel( "(a+b)*.a.b" );
+		Rationnel * a = Lettre( 'a' );
+		Rationnel * b = Lettre( 'b' );
+		Arene * courante = utiliser_arene( precedente );
+		Automate * automate = Glushkov( rat );
+
+		TEST(
+			1
+			&& precedente == NULL
+			&& courante == arene
+			&& (char*) b - (char*) a < 2 * sizeof(Rationnel)
+			&& taille_arene( arene ) >= 9 * sizeof(Rationnel)
+			&& le_mot_est_reconnu( automate, "abab" )
+			&& ! le_mot_est_reconnu( automate, "aba" )
+			, result
+		);
+
+		liberer_automate( automate );
+		liberer_arene( arene );
+	}
+
+	{
+		// Les noeuds créés par Arden, qui partagent des sous-expressions,
+		// sont libérés avec l'arène.
+		Arene * arene = creer_arene();
+		Arene * precedente = utiliser_arene( arene );
+		Automate * automate = creer_automate();
+		ajouter_etat_initial( automate, 0 );
+		ajouter_transition( automate, 0, 'a', 1 );
+		ajouter_transition( automate, 1, 'b', 0 );
+		ajouter_transition( automate, 1, 'a', 2 );
+		ajouter_transition( automate, 2, 'b', 2 );
+		ajouter_etat_final( automate, 0 );
+		ajouter_etat_final( automate, 2 );
+		size_t avant = taille_arene( arene );
+		Rationnel * rat = Arden( automate );
+		Automate * glushkov = Glushkov( rat );
+		utiliser_arene( precedente );
+
+		TEST(
+			1
+			&& rat
+			&& taille_arene( arene ) > avant
+			&& glushkov
+			, result
+		);
+
+		liberer_automate( glushkov );
+		liberer_automate( automate );
+		liberer_arene( arene );
+	}
+
+	return result;
+}
+
+int main(){
+
+	if( ! test_arene() ){ return 1; }
+
+	return 0;
+}
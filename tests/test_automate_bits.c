@@ -0,0 +1,220 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "automate_bits.h"
+#include "rationnel.h"
+#include "outils.h"
+
+#include <string.h>
+
+/*
+ * Compare la simulation bit à bit (automate de Glushkov) et la simulation
+ * par ensembles (copie de l'automate, qui n'a pas de simulation) sur tous 
+ * les mots de longueur au plus 'longueur_max' sur l'alphabet {a, b, c}.
+ */
+int meme_simulation( const Automate* automate, int longueur_max ){
+	Automate * copie = copier_automate( automate );
+	char mot[16];
+	int longueur, i, res = 1;
+	for( longueur = 0; longueur <= longueur_max && res; longueur++ ){
+		int nb_mots = 1;
+		for( i = 0; i < longueur; i++ ) nb_mots *= 3;
+		int numero;
+		for( numero = 0; numero < nb_mots && res; numero++ ){
+			int reste = numero;
+			for( i = 0; i < longueur; i++ ){
+				mot[i] = 'a' + reste % 3;
+				reste /= 3;
+			}
+			mot[longueur] = '\0';
+			Ensemble * e1 = delta_star( automate, get_initiaux( automate ), mot );
+			Ensemble * e2 = delta_star( copie, get_initiaux( copie ), mot );
+			res = 
+				comparer_ensemble( e1, e2 ) == 0
+				&& le_mot_est_reconnu( automate, mot ) == 
+					le_mot_est_reconnu( copie, mot );
+			liberer_ensemble( e1 );
+			liberer_ensemble( e2 );
+		}
+	}
+	liberer_automate( copie );
+	return res;
+}
+
+int test_automate_bits(){
+	int result = 1;
+
+	{
+		const char* expressions[] = {
+			"a", "a.b*", "(a+b)*.a.(a+b)", "(a.b+c)*.c", "a*.b*.c*",
+			"(a+b+c)*.a.b.a"
+		};
+		int i;
+		for( i = 0; i < sizeof(expressions)/sizeof(expressions[0]); i++ ){
+			Rationnel * rat = expression_to_rationnel( expressions[i] );
+			Automate * automate = Glushkov( rat );
+
+			// La simulation n'est construite qu'à la première demande.
+			int avant = automate->simulation == NULL;
+			TEST(
+				1
+				&& avant
+				&& simulation_automate( automate ) != NULL
+				&& meme_simulation( automate, 7 )
+				, result
+			);
+
+			liberer_automate( automate );
+		}
+	}
+
+	{
+		// Plus de 64 positions : l'ensemble des états tient sur plusieurs mots.
+		char expression[1024] = "(a+b)*.a";
+		int i;
+		for( i = 0; i < 70; i++ ) strcat( expression, ".(a+b+c)" );
+		Rationnel * rat = expression_to_rationnel( expression );
+		Automate * automate = Glushkov( rat );
+
+		char mot[80];
+		memset( mot, 'c', 71 );
+		mot[71] = '\0';
+		mot[0] = 'a';
+		int reconnu = le_mot_est_reconnu( automate, mot );
+		mot[0] = 'b';
+		int refuse = ! le_mot_est_reconnu( automate, mot );
+		mot[0] = 'a';
+		mot[70] = '\0';
+
+		TEST(
+			1
+			&& simulation_automate( automate ) != NULL
+			&& simulation_automate( automate )->nb_mots > 1
+			&& simulation_automate( automate )->largeur == 8
+			&& reconnu
+			&& refuse
+			&& ! le_mot_est_reconnu( automate, mot )
+			&& meme_simulation( automate, 4 )
+			, result
+		);
+
+		liberer_automate( automate );
+	}
+
+	{
+		// Avec plus de 2000 positions, les tables de suivants sur 8 bits 
+		// seraient trop grandes : les blocs sont plus petits.
+		char* expression = xmalloc( 16 * 1024 );
+		strcpy( expression, "(a+b)*.a" );
+		int i;
+		for( i = 0; i < 1100; i++ ) strcat( expression, ".(a+b+c)" );
+		Rationnel * rat = expression_to_rationnel( expression );
+		Automate * automate = Glushkov( rat );
+
+		char* mot = xmalloc( 1200 );
+		memset( mot, 'c', 1101 );
+		mot[1101] = '\0';
+		mot[0] = 'a';
+		int reconnu = le_mot_est_reconnu( automate, mot );
+		mot[0] = 'b';
+		int refuse = ! le_mot_est_reconnu( automate, mot );
+		mot[0] = 'a';
+		mot[1100] = '\0';
+
+		TEST(
+			1
+			&& simulation_automate( automate ) != NULL
+			&& simulation_automate( automate )->largeur < 8
+			&& reconnu
+			&& refuse
+			&& ! le_mot_est_reconnu( automate, mot )
+			&& meme_simulation( automate, 3 )
+			, result
+		);
+
+		xfree( mot );
+		xfree( expression );
+		liberer_automate( automate );
+	}
+
+	{
+		// Un automate non homogène n'est pas simulé bit à bit.
+		Automate * automate = creer_automate();
+		ajouter_etat_initial( automate, 0 );
+		ajouter_transition( automate, 0, 'a', 1 );
+		ajouter_transition( automate, 0, 'b', 1 );
+		Automate_bits * bits = creer_automate_bits( automate );
+
+		TEST(
+			1
+			&& bits == NULL
+			, result
+		);
+
+		liberer_automate( automate );
+	}
+
+	{
+		// Déterminiser un automate de Glushkov ne construit pas sa 
+		// simulation.
+		Rationnel * rat = expression_to_rationnel( "(a+b)*.a.b" );
+		Automate * automate = Glushkov( rat );
+		Automate * deterministe = creer_automate_deterministe( automate );
+		int sans_simulation = automate->simulation == NULL;
+		TEST(
+			1
+			&& sans_simulation
+			&& le_mot_est_reconnu( deterministe, "abab" )
+			&& le_mot_est_reconnu( automate, "abab" )
+			&& automate->simulation != NULL
+			, result
+		);
+		liberer_automate( deterministe );
+		liberer_automate( automate );
+	}
+
+	{
+		// Modifier l'automate détruit sa simulation.
+		Rationnel * rat = expression_to_rationnel( "a.b" );
+		Automate * automate = Glushkov( rat );
+		int avant = le_mot_est_reconnu( automate, "a" );
+		ajouter_etat_final( automate, 1 );
+
+		TEST(
+			1
+			&& ! avant
+			&& automate->simulation == NULL
+			&& simulation_automate( automate ) == NULL
+			&& le_mot_est_reconnu( automate, "a" )
+			, result
+		);
+
+		liberer_automate( automate );
+	}
+
+	return result;
+}
+
+int main(){
+
+	if( ! test_automate_bits() ){ return 1; }
+
+	return 0;
+}
@@ -0,0 +1,197 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define _DEFAULT_SOURCE
+
+#include "automate_compile.h"
+#include "rationnel.h"
+#include "outils.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/*
+ * Programme qui affiche, pour chaque mot de longueur au plus 'longueur_max'
+ * sur les 'nb_lettres' octets à partir de 'premiere', dans l'ordre de 
+ * meme_reconnaissance(), 1 si le mot est reconnu par la fonction générée 
+ * et 0 sinon. Ces paramètres sont remplis par fprintf().
+ */
+static const char* programme =
+	"#include <stdio.h>\n"
+	"#include \"automate.c\"\n"
+	"int main(){\n"
+	"	char mot[16];\n"
+	"	int longueur, numero, i, nb_mots, reste;\n"
+	"	for( longueur = 0; longueur <= %d; longueur++ ){\n"
+	"		for( nb_mots = 1, i = 0; i < longueur; i++ ) nb_mots *= %d;\n"
+	"		for( numero = 0; numero < nb_mots; numero++ ){\n"
+	"			for( reste = numero, i = 0; i < longueur; i++ ){\n"
+	"				mot[i] = (char) ( %d + reste %% %d );\n"
+	"				reste /= %d;\n"
+	"			}\n"
+	"			putchar( reconnaitre( mot, longueur ) ? '1' : '0' );\n"
+	"		}\n"
+	"	}\n"
+	"	return 0;\n"
+	"}\n";
+
+/*
+ * Renvoie 1 si le mot est reconnu par l'automate. Un mot qui contient un 
+ * octet nul ne peut pas être donné à le_mot_est_reconnu() : il est lu 
+ * lettre par lettre avec delta().
+ */
+static int est_reconnu( const Automate* automate, const char* mot, int longueur ){
+	if( ! memchr( mot, '\0', longueur ) ){
+		return le_mot_est_reconnu( automate, mot );
+	}
+	Ensemble* etats = copier_ensemble( get_initiaux( automate ) );
+	int i;
+	for( i = 0; i < longueur; i++ ){
+		Ensemble* suivants = delta( automate, etats, mot[i] );
+		liberer_ensemble( etats );
+		etats = suivants;
+	}
+	Ensemble* finaux = creer_intersection_ensemble( etats, get_finaux( automate ) );
+	int res = taille_ensemble( finaux ) > 0;
+	liberer_ensemble( finaux );
+	liberer_ensemble( etats );
+	return res;
+}
+
+/*
+ * Génère, compile et exécute le code C de l'automate, puis compare ses 
+ * réponses à celles de le_mot_est_reconnu() sur tous les mots de longueur 
+ * au plus 'longueur_max' sur les 'nb_lettres' octets à partir de 
+ * 'premiere'.
+ */
+int meme_reconnaissance( 
+	const Automate* automate, int premiere, int nb_lettres, int longueur_max 
+){
+	char dossier[] = "/tmp/test_automate_c_XXXXXX";
+	char chemin[256], commande[1024];
+	if( ! mkdtemp( dossier ) ) return 0;
+
+	snprintf( chemin, sizeof(chemin), "%s/automate.c", dossier );
+	FILE* f = fopen( chemin, "w" );
+	ecrire_automate_c( automate, "reconnaitre", f );
+	fclose( f );
+	snprintf( chemin, sizeof(chemin), "%s/programme.c", dossier );
+	f = fopen( chemin, "w" );
+	fprintf( f, programme, 
+		longueur_max, nb_lettres, premiere, nb_lettres, nb_lettres 
+	);
+	fclose( f );
+
+	const char* cc = getenv( "CC" ) ? getenv( "CC" ) : "cc";
+	snprintf( commande, sizeof(commande), 
+		"%s -std=c11 -Wall -Werror -o %s/programme %s/programme.c", 
+		cc, dossier, dossier
+	);
+	int res = system( commande ) == 0;
+
+	if( res ){
+		snprintf( commande, sizeof(commande), "%s/programme", dossier );
+		FILE* sortie = popen( commande, "r" );
+		char mot[16];
+		int longueur, numero, i;
+		for( longueur = 0; longueur <= longueur_max && res; longueur++ ){
+			int nb_mots = 1;
+			for( i = 0; i < longueur; i++ ) nb_mots *= nb_lettres;
+			for( numero = 0; numero < nb_mots && res; numero++ ){
+				int reste = numero;
+				for( i = 0; i < longueur; i++ ){
+					mot[i] = (char) ( premiere + reste % nb_lettres );
+					reste /= nb_lettres;
+				}
+				mot[longueur] = '\0';
+				int attendu = est_reconnu( automate, mot, longueur ) ? '1' : '0';
+				res = fgetc( sortie ) == attendu;
+			}
+		}
+		res &= fgetc( sortie ) == EOF;
+		res &= pclose( sortie ) == 0;
+	}
+
+	snprintf( chemin, sizeof(chemin), "%s/automate.c", dossier );
+	remove( chemin );
+	snprintf( chemin, sizeof(chemin), "%s/programme.c", dossier );
+	remove( chemin );
+	snprintf( chemin, sizeof(chemin), "%s/programme", dossier );
+	remove( chemin );
+	rmdir( dossier );
+	return res;
+}
+
+int test_automate_c(){
+	int result = 1;
+
+	{
+		const char* expressions[] = {
+			"a", "a.b*", "(a+b)*.a.(a+b)", "(a.b+c)*.c", "(a+b+c)*.a.b.a"
+		};
+		int i;
+		for( i = 0; i < sizeof(expressions)/sizeof(expressions[0]); i++ ){
+			Rationnel * rat = expression_to_rationnel( expressions[i] );
+			Automate * automate = Glushkov( rat );
+			Automate * minimal = creer_automate_minimal( automate );
+
+			TEST(
+				1
+				&& meme_reconnaissance( automate, 'a', 3, 6 )
+				&& meme_reconnaissance( minimal, 'a', 3, 6 )
+				, result
+			);
+
+			liberer_automate( minimal );
+			liberer_automate( automate );
+		}
+	}
+
+	{
+		// Avec 257 classes, la table des classes générée est sur 16 bits : 
+		// tous les mots d'au plus deux octets sont comparés, octets nuls et
+		// octets de 128 à 255 compris.
+		Automate * automate = creer_automate();
+		int o;
+		for( o = 0; o < 256; o++ ){
+			ajouter_transition( automate, 0, (char) o, o + 1 );
+			ajouter_transition( automate, o + 1, (char) o, 300 );
+		}
+		ajouter_etat_initial( automate, 0 );
+		ajouter_etat_final( automate, 300 );
+		TEST(
+			1
+			&& meme_reconnaissance( automate, 0, 256, 2 )
+			, result
+		);
+		liberer_automate( automate );
+	}
+
+	return result;
+}
+
+int main(){
+
+	if( ! test_automate_c() ){ return 1; }
+
+	return 0;
+}
@@ -0,0 +1,153 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "automate_compile.h"
+#include "rationnel.h"
+#include "outils.h"
+
+#include <string.h>
+
+/*
+ * Compare la reconnaissance compilée et le_mot_est_reconnu() sur tous les
+ * mots de longueur au plus 'longueur_max' sur l'alphabet {a, b, c}.
+ */
+int meme_reconnaissance( 
+	const Automate* automate, const Automate_compile* compile, int longueur_max
+){
+	char mot[16];
+	int longueur, i;
+	for( longueur = 0; longueur <= longueur_max; longueur++ ){
+		int nb_mots = 1;
+		for( i = 0; i < longueur; i++ ) nb_mots *= 3;
+		int numero;
+		for( numero = 0; numero < nb_mots; numero++ ){
+			int reste = numero;
+			for( i = 0; i < longueur; i++ ){
+				mot[i] = 'a' + reste % 3;
+				reste /= 3;
+			}
+			mot[longueur] = '\0';
+			if( 
+				le_mot_est_reconnu( automate, mot ) != 
+				le_mot_est_reconnu_compile( compile, mot, longueur )
+			){
+				return 0;
+			}
+		}
+	}
+	return 1;
+}
+
+int test_automate_compile(){
+	int result = 1;
+
+	{
+		Automate * automate = creer_automate();
+		ajouter_etat_initial( automate, 3 );
+		ajouter_transition( automate, 3, 'a', 5 );
+		ajouter_transition( automate, 5, 'b', 3 );
+		ajouter_transition( automate, 5, 'a', 8 );
+		ajouter_etat_final( automate, 5 );
+
+		Automate_compile * compile = compiler_automate( automate );
+
+		TEST(
+			1
+			&& compile->nb_etats == 3
+			&& le_mot_est_reconnu_compile( compile, "aba", 3 )
+			&& ! le_mot_est_reconnu_compile( compile, "ab", 2 )
+			&& ! le_mot_est_reconnu_compile( compile, "aa", 2 )
+			&& ! le_mot_est_reconnu_compile( compile, "a\0", 2 )
+			&& ! le_mot_est_reconnu_compile( compile, "", 0 )
+			&& meme_reconnaissance( automate, compile, 6 )
+			, result
+		);
+
+		liberer_automate_compile( compile );
+		liberer_automate( automate );
+	}
+
+	{
+		const char* expressions[] = {
+			"a", "a.b*", "(a+b)*.a.(a+b)", "(a.b+c)*.c", "a*.b*.c*",
+			"(a+b+c)*.a.b.a"
+		};
+		int i;
+		for( i = 0; i < sizeof(expressions)/sizeof(expressions[0]); i++ ){
+			Rationnel * rat = expression_to_rationnel( expressions[i] );
+			Automate * automate = Glushkov( rat );
+			Automate_compile * compile = compiler_automate( automate );
+			Automate * minimal = creer_automate_minimal( automate );
+			Automate_compile * compile_minimal = compiler_automate( minimal );
+
+			TEST(
+				1
+				&& meme_reconnaissance( automate, compile, 7 )
+				&& meme_reconnaissance( minimal, compile_minimal, 7 )
+				, result
+			);
+
+			liberer_automate_compile( compile_minimal );
+			liberer_automate_compile( compile );
+			liberer_automate( minimal );
+			liberer_automate( automate );
+		}
+	}
+
+	{
+		// Les 256 octets sont des lettres distinctes : l'octet 255 ne doit 
+		// pas tomber dans la classe 0 des octets hors de l'alphabet.
+		Automate * automate = creer_automate();
+		int o;
+		for( o = 0; o < 256; o++ ){
+			ajouter_transition( automate, 0, (char) o, o + 1 );
+			ajouter_transition( automate, o + 1, (char) o, 300 );
+		}
+		ajouter_etat_initial( automate, 0 );
+		ajouter_etat_final( automate, 300 );
+		Automate_compile * compile = compiler_automate( automate );
+		int reconnus = 1;
+		for( o = 0; o < 256; o++ ){
+			char mot[2] = { (char) o, (char) o };
+			char faux[2] = { (char) o, (char) ( o + 1 ) };
+			reconnus &= le_mot_est_reconnu_compile( compile, mot, 2 )
+				&& ! le_mot_est_reconnu_compile( compile, faux, 2 );
+		}
+		TEST(
+			1
+			&& compile->nb_classes == 257
+			&& compile->classes[255] != 0
+			&& compile->classes[255] != compile->classes[0]
+			&& reconnus
+			, result
+		);
+		liberer_automate_compile( compile );
+		liberer_automate( automate );
+	}
+
+	return result;
+}
+
+int main(){
+
+	if( ! test_automate_compile() ){ return 1; }
+
+	return 0;
+}
@@ -0,0 +1,104 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "automate.h"
+#include "ensemble.h"
+#include "outils.h"
+
+int test_automate_emonde(){
+	int result = 1;
+
+	{
+		// 0 -a-> 1 -b-> 2 (final), 1 -a-> 3 (puits), 4 -a-> 2 (inaccessible).
+		Automate * automate = creer_automate();
+		ajouter_transition( automate, 0, 'a', 1 );
+		ajouter_transition( automate, 1, 'b', 2 );
+		ajouter_transition( automate, 1, 'a', 3 );
+		ajouter_transition( automate, 3, 'a', 3 );
+		ajouter_transition( automate, 4, 'a', 2 );
+		ajouter_etat( automate, 5 );
+		ajouter_etat_initial( automate, 0 );
+		ajouter_etat_final( automate, 2 );
+
+		Ensemble * access = accessibles( automate );
+		Ensemble * coaccess = coaccessibles( automate );
+		Ensemble * depuis_3 = etats_accessibles( automate, 3 );
+		Automate * emonde = automate_emonde( automate );
+		Automate * accessible = automate_accessible( automate );
+
+		TEST(
+			1
+			&& taille_ensemble( access ) == 4
+			&& ! est_dans_l_ensemble( access, 4 )
+			&& ! est_dans_l_ensemble( access, 5 )
+			&& taille_ensemble( coaccess ) == 4
+			&& est_dans_l_ensemble( coaccess, 4 )
+			&& ! est_dans_l_ensemble( coaccess, 3 )
+			&& taille_ensemble( depuis_3 ) == 1
+			&& taille_ensemble( get_etats( emonde ) ) == 3
+			&& nombre_de_transitions( emonde ) == 2
+			&& est_un_etat_initial_de_l_automate( emonde, 0 )
+			&& est_un_etat_final_de_l_automate( emonde, 2 )
+			&& le_mot_est_reconnu( emonde, "ab" )
+			&& taille_ensemble( get_etats( accessible ) ) == 4
+			&& nombre_de_transitions( accessible ) == 4
+			, result
+		);
+		liberer_ensemble( access );
+		liberer_ensemble( coaccess );
+		liberer_ensemble( depuis_3 );
+		liberer_automate( emonde );
+		liberer_automate( accessible );
+		liberer_automate( automate );
+	}
+
+	{
+		// Une chaîne de n états, dont la moitié mène à un puits : le 
+		// parcours ne fait qu'une passe, quel que soit n.
+		int n = 50000, i;
+		Automate * automate = creer_automate();
+		for( i = 0; i < n; i++ ){
+			ajouter_transition( automate, i, 'a', i + 1 );
+			ajouter_transition( automate, i, 'b', n + 1 + i );
+		}
+		ajouter_etat_initial( automate, 0 );
+		ajouter_etat_final( automate, n );
+
+		Automate * emonde = automate_emonde( automate );
+
+		TEST(
+			1
+			&& taille_ensemble( get_etats( emonde ) ) == n + 1
+			&& nombre_de_transitions( emonde ) == n
+			, result
+		);
+		liberer_automate( emonde );
+		liberer_automate( automate );
+	}
+
+	return result;
+}
+
+int main(){
+
+	if( ! test_automate_emonde() ){ return 1; }
+
+	return 0;
+}
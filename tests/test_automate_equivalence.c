@@ -0,0 +1,212 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "automate_equivalence.h"
+#include "rationnel.h"
+#include "outils.h"
+
+#include <string.h>
+
+int test_automate_equivalence(){
+	int result = 1;
+
+	{
+		const char* equivalentes[][2] = {
+			{ "a.(b.a)*", "(a.b)*.a" },
+			{ "(a+b)*", "(a*.b*)*" },
+			{ "(a+b)*", "(a*.b)*.a*" },
+			{ "a*.a*", "a*" },
+			{ "(a.a)*.a+a.(a.a)*", "a.(a.a)*" },
+		};
+		int i, correct = 1;
+		for( i = 0; i < sizeof(equivalentes) / sizeof(equivalentes[0]); i++ ){
+			Automate* a1 = Glushkov( expression_to_rationnel( equivalentes[i][0] ) );
+			Automate* a2 = Glushkov( expression_to_rationnel( equivalentes[i][1] ) );
+			char* mot = NULL;
+			correct &= automates_equivalents( a1, a2, &mot );
+			correct &= mot == NULL;
+			liberer_automate( a1 );
+			liberer_automate( a2 );
+		}
+
+		TEST(
+			1
+			&& correct
+			, result
+		);
+	}
+
+	{
+		const char* differentes[][3] = {
+			{ "a", "b", "a" },
+			{ "(a+b)*", "(a.b)*", "a" },
+			{ "a.b.c", "a.b.c+a.b.c.c", "abcc" },
+			{ "a*", "a.a*", "" },
+			{ "(a.a)*", "(a.a.a)*", "aa" },
+		};
+		int i, correct = 1;
+		for( i = 0; i < sizeof(differentes) / sizeof(differentes[0]); i++ ){
+			Automate* a1 = Glushkov( expression_to_rationnel( differentes[i][0] ) );
+			Automate* a2 = Glushkov( expression_to_rationnel( differentes[i][1] ) );
+			char* mot = NULL;
+			correct &= ! automates_equivalents( a1, a2, &mot );
+			correct &= mot != NULL;
+			if( mot ){
+				// Le parcours est en largeur : le contre-exemple est ici le 
+				// plus court.
+				correct &= strcmp( mot, differentes[i][2] ) == 0;
+				correct &= le_mot_est_reconnu( a1, mot ) != le_mot_est_reconnu( a2, mot );
+				xfree( mot );
+			}
+			correct &= ! automates_equivalents( a2, a1, NULL );
+			liberer_automate( a1 );
+			liberer_automate( a2 );
+		}
+
+		TEST(
+			1
+			&& correct
+			, result
+		);
+	}
+
+	{
+		// Un automate non déterministe de n+1 états, dont le déterminisé 
+		// minimal en a 2^n, et le même automate qui reconnaît en plus les
+		// mots de a dont la dernière lettre a est suivie d'autres a.
+		int n = 12, i;
+		Automate* a = creer_automate();
+		ajouter_transition( a, 0, 'a', 0 );
+		ajouter_transition( a, 0, 'b', 0 );
+		ajouter_transition( a, 0, 'a', 1 );
+		for( i = 1; i < n; i++ ){
+			ajouter_transition( a, i, 'a', i + 1 );
+			ajouter_transition( a, i, 'b', i + 1 );
+		}
+		ajouter_etat_initial( a, 0 );
+		ajouter_etat_final( a, n );
+		Automate* b = copier_automate( a );
+		ajouter_transition( b, n, 'a', n );
+
+		char* mot = NULL;
+		Automate* c = copier_automate( a );
+		int egaux = automates_equivalents( a, c, NULL );
+		int differents = ! automates_equivalents( a, b, &mot );
+
+		TEST(
+			1
+			&& egaux
+			&& differents
+			&& mot != NULL
+			&& strlen( mot ) == n + 1
+			&& le_mot_est_reconnu( b, mot )
+			&& ! le_mot_est_reconnu( a, mot )
+			, result
+		);
+		xfree( mot );
+		liberer_automate( a );
+		liberer_automate( b );
+		liberer_automate( c );
+	}
+
+	{
+		// Le mot distinguant est de longueur minimale : aucun mot plus 
+		// court sur {a, b, c} ne distingue les automates.
+		const char* couples[][2] = {
+			{ "(a.a)*", "(a.a.a)*" },
+			{ "a.b.c+b", "b+a.b.c+a.b.c.c.c" },
+			{ "(a+b)*.a.(a+b).(a+b)", "(a+b)*.a.(a+b)" },
+			{ "a.(b.a)*", "(a.b)*.a" },
+		};
+		int i, correct = 1;
+		for( i = 0; i < sizeof(couples) / sizeof(couples[0]); i++ ){
+			Automate* a1 = Glushkov( expression_to_rationnel( couples[i][0] ) );
+			Automate* a2 = Glushkov( expression_to_rationnel( couples[i][1] ) );
+			char* mot = mot_distinguant( a1, a2 );
+			int longueur_max = mot ? strlen( mot ) - 1 : 6;
+			if( mot ){
+				correct &= le_mot_est_reconnu( a1, mot ) != le_mot_est_reconnu( a2, mot );
+			}
+			int longueur, code, j, max;
+			char court[8];
+			for( longueur = 0; longueur <= longueur_max; longueur++ ){
+				for( max = 1, j = 0; j < longueur; j++ ) max *= 3;
+				for( code = 0; code < max; code++ ){
+					int reste = code;
+					for( j = 0; j < longueur; j++ ){
+						court[j] = "abc"[ reste % 3 ];
+						reste /= 3;
+					}
+					court[longueur] = '\0';
+					correct &= le_mot_est_reconnu( a1, court ) == le_mot_est_reconnu( a2, court );
+				}
+			}
+			xfree( mot );
+			liberer_automate( a1 );
+			liberer_automate( a2 );
+		}
+
+		char* mot = NULL;
+		int meme = meme_langage_contre_exemple( "a.b.c+b", "b+a.b.c+a.b.c.c.c", &mot );
+
+		TEST(
+			1
+			&& correct
+			&& ! meme
+			&& mot != NULL
+			&& strcmp( mot, "abccc" ) == 0
+			, result
+		);
+		xfree( mot );
+	}
+
+	{
+		char* mot_1 = NULL;
+		char* mot_2 = NULL;
+		char* mot_3 = NULL;
+		int inclus_1 = langage_inclus( "a.b", "(a+b)*", &mot_1 );
+		int inclus_2 = langage_inclus( "(a+b)*", "a*", &mot_2 );
+		int inclus_3 = langage_inclus( "a.(a+b)*", "(a.a+a.b)*", &mot_3 );
+		int inclus_4 = langage_inclus( "(a.a+a.b)*.a.(a+b)", "a.(a+b)*", NULL );
+
+		TEST(
+			1
+			&& inclus_1
+			&& mot_1 == NULL
+			&& ! inclus_2
+			&& mot_2 && strcmp( mot_2, "b" ) == 0
+			&& ! inclus_3
+			&& mot_3 && strcmp( mot_3, "a" ) == 0
+			&& inclus_4
+			, result
+		);
+		xfree( mot_2 );
+		xfree( mot_3 );
+	}
+
+	return result;
+}
+
+int main(){
+
+	if( ! test_automate_equivalence() ){ return 1; }
+
+	return 0;
+}
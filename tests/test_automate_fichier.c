@@ -0,0 +1,197 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define _DEFAULT_SOURCE
+
+#include "automate_fichier.h"
+#include "rationnel.h"
+#include "outils.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/*
+ * Compare l'automate, l'automate rechargé et l'automate projeté sur tous 
+ * les mots de longueur au plus 'longueur_max' sur l'alphabet {a, b, c}.
+ */
+int meme_reconnaissance( 
+	const Automate* automate, const Automate* charge, 
+	const Automate_projete* projete, int longueur_max
+){
+	char mot[16];
+	int longueur, i;
+	for( longueur = 0; longueur <= longueur_max; longueur++ ){
+		int nb_mots = 1;
+		for( i = 0; i < longueur; i++ ) nb_mots *= 3;
+		int numero;
+		for( numero = 0; numero < nb_mots; numero++ ){
+			int reste = numero;
+			for( i = 0; i < longueur; i++ ){
+				mot[i] = 'a' + reste % 3;
+				reste /= 3;
+			}
+			mot[longueur] = '\0';
+			int attendu = le_mot_est_reconnu( automate, mot );
+			if( 
+				le_mot_est_reconnu( charge, mot ) != attendu 
+				|| le_mot_est_reconnu_projete( projete, mot, longueur ) != attendu
+			){
+				return 0;
+			}
+		}
+	}
+	return 1;
+}
+
+int memes_ensembles( const Automate* a, const Automate* b ){
+	return 
+		comparer_ensemble( get_etats( a ), get_etats( b ) ) == 0
+		&& comparer_ensemble( get_alphabet( a ), get_alphabet( b ) ) == 0
+		&& comparer_ensemble( get_initiaux( a ), get_initiaux( b ) ) == 0
+		&& comparer_ensemble( get_finaux( a ), get_finaux( b ) ) == 0
+		&& nombre_de_transitions( a ) == nombre_de_transitions( b );
+}
+
+int test_automate_fichier(){
+	int result = 1;
+	char chemin[] = "/tmp/test_automate_fichier_XXXXXX";
+	int fd = mkstemp( chemin );
+	close( fd );
+
+	{
+		const char* expressions[] = {
+			"a", "a.b*", "(a+b)*.a.(a+b)", "(a.b+c)*.c", "(a+b+c)*.a.b.a"
+		};
+		int i;
+		for( i = 0; i < sizeof(expressions)/sizeof(expressions[0]); i++ ){
+			Rationnel * rat = expression_to_rationnel( expressions[i] );
+			Automate * automates[2];
+			automates[0] = Glushkov( rat );
+			automates[1] = creer_automate_minimal( automates[0] );
+			int j;
+			for( j = 0; j < 2; j++ ){
+				int sauve = sauver_automate( automates[j], chemin );
+				Automate * charge = charger_automate( chemin );
+				Automate_projete * projete = projeter_automate( chemin );
+
+				TEST(
+					1
+					&& sauve
+					&& charge
+					&& projete
+					&& projete->entete->deterministe == est_deterministe( automates[j] )
+					&& memes_ensembles( automates[j], charge )
+					&& meme_reconnaissance( automates[j], charge, projete, 6 )
+					, result
+				);
+
+				liberer_automate_projete( projete );
+				liberer_automate( charge );
+				liberer_automate( automates[j] );
+			}
+		}
+	}
+
+	{
+		// Des états qui ne sont pas numérotés de 0 à n-1.
+		Automate * automate = creer_automate();
+		ajouter_etat_initial( automate, -5 );
+		ajouter_etat_initial( automate, 100 );
+		ajouter_etat( automate, 7 );
+		ajouter_lettre( automate, 'z' );
+		ajouter_transition( automate, -5, 'a', 100 );
+		ajouter_transition( automate, 100, 'b', -5 );
+		ajouter_transition( automate, 100, 'b', 100 );
+		ajouter_etat_final( automate, 100 );
+		sauver_automate( automate, chemin );
+		Automate * charge = charger_automate( chemin );
+		Automate_projete * projete = projeter_automate( chemin );
+
+		TEST(
+			1
+			&& charge
+			&& projete
+			&& memes_ensembles( automate, charge )
+			&& est_une_transition_de_l_automate( charge, 100, 'b', -5 )
+			&& meme_reconnaissance( automate, charge, projete, 6 )
+			, result
+		);
+
+		liberer_automate_projete( projete );
+		liberer_automate( charge );
+		liberer_automate( automate );
+	}
+
+	{
+		// Fichiers invalides.
+		Automate * automate = creer_automate();
+		ajouter_etat_initial( automate, 0 );
+		ajouter_transition( automate, 0, 'a', 1 );
+		ajouter_etat_final( automate, 1 );
+		sauver_automate( automate, chemin );
+		truncate( chemin, 40 );
+		Automate * tronque = charger_automate( chemin );
+		Automate_projete * projete = projeter_automate( chemin );
+
+		sauver_automate( automate, chemin );
+		FILE* f = fopen( chemin, "r+b" );
+		fseek( f, sizeof(Automate_entete) + 3 * sizeof(int32_t), SEEK_SET );
+		int32_t faux = 12;
+		fwrite( &faux, sizeof(int32_t), 1, f );
+		fclose( f );
+		Automate * corrompu = charger_automate( chemin );
+
+		// 2 états, 1 lettre, 1 initial, 1 final, puis debut = {0, 1, 1} : 
+		// debut[1] est remplacé par une borne hors du tableau des lettres.
+		sauver_automate( automate, chemin );
+		f = fopen( chemin, "r+b" );
+		fseek( f, sizeof(Automate_entete) + 6 * sizeof(int32_t), SEEK_SET );
+		faux = 200000000;
+		fwrite( &faux, sizeof(int32_t), 1, f );
+		fclose( f );
+		Automate * debut_invalide = charger_automate( chemin );
+		Automate_projete * debut_invalide_projete = projeter_automate( chemin );
+
+		TEST(
+			1
+			&& ! tronque
+			&& ! projete
+			&& ! corrompu
+			&& ! debut_invalide
+			&& ! debut_invalide_projete
+			&& ! charger_automate( "/inexistant/automate" )
+			&& ! projeter_automate( "/inexistant/automate" )
+			, result
+		);
+		liberer_automate( automate );
+	}
+
+	remove( chemin );
+	return result;
+}
+
+int main(){
+
+	if( ! test_automate_fichier() ){ return 1; }
+
+	return 0;
+}
@@ -0,0 +1,172 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "automate_fige.h"
+#include "rationnel.h"
+#include "outils.h"
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define NB_FILS 8
+#define NB_MOTS 200
+#define NB_TOURS 20
+
+typedef struct Lecteur {
+	const Automate_fige* automate;
+	char (*mots)[16];
+	const int* attendus;
+	int premier;
+	int erreurs;
+	pthread_t id;
+} Lecteur;
+
+/*
+ * Chaque lecteur reconnaît tous les mots, calcule des images par delta et
+ * parcourt toutes les transitions, plusieurs fois et dans un ordre qui 
+ * dépend du lecteur.
+ */
+static void* lire( void* argument ){
+	Lecteur* lecteur = argument;
+	const Automate_fige* automate = lecteur->automate;
+	int tour, i, j;
+	for( tour = 0; tour < NB_TOURS; tour++ ){
+		for( i = 0; i < NB_MOTS; i++ ){
+			int k = ( i + lecteur->premier ) % NB_MOTS;
+			if( 
+				le_mot_est_reconnu_fige( automate, lecteur->mots[k] ) 
+				!= lecteur->attendus[k] 
+			){
+				lecteur->erreurs++;
+			}
+		}
+		Ensemble * etats = creer_ensemble( NULL, NULL, NULL );
+		for( i = 0; i < automate->nb_initiaux; i++ ){
+			ajouter_element( etats, automate->etats[ automate->initiaux[i] ] );
+		}
+		for( i = 0; i < 8; i++ ){
+			Ensemble * suivants = delta_fige( automate, etats, "abc"[ i % 3 ] );
+			liberer_ensemble( etats );
+			etats = suivants;
+		}
+		liberer_ensemble( etats );
+		int nb_transitions = 0;
+		for( i = 0; i < automate->nb_etats; i++ ){
+			for( j = automate->debut[i]; j < automate->debut[i+1]; j++ ){
+				nb_transitions += automate->voisins[j] >= 0;
+			}
+		}
+		if( nb_transitions != automate->nb_transitions ) lecteur->erreurs++;
+	}
+	return NULL;
+}
+
+int test_automate_fige(){
+	int result = 1;
+
+	{
+		Rationnel * rat = expression_to_rationnel( "(a+b+c)*.a.b.(a+c)*" );
+		Automate * automate = Glushkov( rat );
+		Automate_fige * fige = figer_automate( automate );
+
+		Ensemble * initiaux = copier_ensemble( get_initiaux( automate ) );
+		Ensemble * attendu = delta( automate, initiaux, 'a' );
+		Ensemble * obtenu = delta_fige( fige, initiaux, 'a' );
+		TEST(
+			1
+			&& fige->nb_etats == taille_ensemble( get_etats( automate ) )
+			&& fige->taille_alphabet == 3
+			&& comparer_ensemble( attendu, obtenu ) == 0
+			&& numero_etat_fige( fige, 1000 ) == -1
+			&& le_mot_est_reconnu_fige( fige, "cab" )
+			&& le_mot_est_reconnu_fige( fige, "abac" )
+			&& ! le_mot_est_reconnu_fige( fige, "abb" )
+			&& ! le_mot_est_reconnu_fige( fige, "" )
+			, result
+		);
+		liberer_ensemble( initiaux );
+		liberer_ensemble( attendu );
+		liberer_ensemble( obtenu );
+
+		// L'automate figé ne dépend plus de l'automate.
+		liberer_automate( automate );
+		TEST(
+			1
+			&& le_mot_est_reconnu_fige( fige, "ab" )
+			, result
+		);
+		liberer_automate_fige( fige );
+	}
+
+	{
+		// Plusieurs fils lisent le même automate figé en même temps.
+		Rationnel * rat = expression_to_rationnel( "(a+b)*.a.(a+b).(a+b).c*" );
+		Automate * automate = Glushkov( rat );
+		Automate_fige * fige = figer_automate( automate );
+
+		char (*mots)[16] = xmalloc( NB_MOTS * sizeof(*mots) );
+		int* attendus = xmalloc( NB_MOTS * sizeof(int) );
+		int i, j;
+		srand( 7 );
+		for( i = 0; i < NB_MOTS; i++ ){
+			int longueur = rand() % 15;
+			for( j = 0; j < longueur; j++ ) mots[i][j] = "abc"[ rand() % 3 ];
+			mots[i][longueur] = '\0';
+			attendus[i] = le_mot_est_reconnu( automate, mots[i] );
+		}
+
+		Lecteur lecteurs[NB_FILS];
+		for( i = 0; i < NB_FILS; i++ ){
+			lecteurs[i].automate = fige;
+			lecteurs[i].mots = mots;
+			lecteurs[i].attendus = attendus;
+			lecteurs[i].premier = i * ( NB_MOTS / NB_FILS );
+			lecteurs[i].erreurs = 0;
+			if( pthread_create( &lecteurs[i].id, NULL, lire, &lecteurs[i] ) ){
+				ERREUR( "Impossible de créer un fil d'exécution" );
+			}
+		}
+		int erreurs = 0;
+		for( i = 0; i < NB_FILS; i++ ){
+			pthread_join( lecteurs[i].id, NULL );
+			erreurs += lecteurs[i].erreurs;
+		}
+		TEST(
+			1
+			&& erreurs == 0
+			, result
+		);
+
+		xfree( attendus );
+		xfree( mots );
+		liberer_automate_fige( fige );
+		liberer_automate( automate );
+	}
+
+	return result;
+}
+
+int main(){
+
+	if( ! test_automate_fige() ){ return 1; }
+
+	return 0;
+}
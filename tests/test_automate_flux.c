@@ -0,0 +1,119 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "automate_flux.h"
+#include "rationnel.h"
+#include "outils.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+int test_automate_flux(){
+	int result = 1;
+	srand( 42 );
+
+	{
+		// Un mot coupé en morceaux au hasard est reconnu comme le mot entier.
+		Rationnel * rat = expression_to_rationnel( "(a+b+c)*.a.(b+c).(a+b+c)" );
+		Automate * automate = Glushkov( rat );
+		Automate_compile * compile = compiler_automate( automate );
+		Automate_flux flux;
+		initialiser_flux( &flux, compile );
+		char mot[64];
+		int n, i, memes = 1;
+		for( n = 0; n < 2000; n++ ){
+			int longueur = rand() % 40;
+			for( i = 0; i < longueur; i++ ) mot[i] = 'a' + rand() % 3;
+			reinitialiser_flux( &flux );
+			int lu = 0;
+			while( lu < longueur ){
+				int morceau = rand() % ( longueur - lu + 1 );
+				lire_flux( &flux, mot + lu, morceau );
+				lu += morceau;
+			}
+			memes &= 
+				flux_accepte( &flux ) == 
+				le_mot_est_reconnu_compile( compile, mot, longueur );
+			memes &= flux.position == longueur;
+		}
+
+		TEST(
+			1
+			&& memes
+			, result
+		);
+
+		liberer_automate_compile( compile );
+		liberer_automate( automate );
+	}
+
+	{
+		// Octets nuls, état mort et flux très long sans allocation.
+		Rationnel * rat = expression_to_rationnel( "(a+b)*.b" );
+		Automate * automate = Glushkov( rat );
+		Automate_flux * flux = creer_automate_flux( automate );
+
+		lire_flux( flux, "ab", 2 );
+		int accepte = flux_accepte( flux );
+		lire_flux( flux, "a", 1 );
+		int refuse = ! flux_accepte( flux ) && ! flux_est_mort( flux );
+
+		char morceau[4096];
+		int i;
+		for( i = 0; i < sizeof(morceau); i++ ) morceau[i] = 'a' + i % 2;
+		reinitialiser_flux( flux );
+		size_t avant = nombre_allocations();
+		for( i = 0; i < 10000; i++ ){
+			lire_flux( flux, morceau, sizeof(morceau) );
+		}
+		lire_flux( flux, "b", 1 );
+		int long_accepte = flux_accepte( flux );
+		int sans_allocation = nombre_allocations() == avant;
+
+		reinitialiser_flux( flux );
+		lire_flux( flux, "a\0b", 3 );
+		int mort = flux_est_mort( flux ) && ! flux_accepte( flux );
+		lire_flux( flux, "b", 1 );
+
+		TEST(
+			1
+			&& accepte
+			&& refuse
+			&& long_accepte
+			&& sans_allocation
+			&& flux->position == 4
+			&& mort
+			&& flux_est_mort( flux )
+			, result
+		);
+
+		liberer_automate_flux( flux );
+		liberer_automate( automate );
+	}
+
+	return result;
+}
+
+int main(){
+
+	if( ! test_automate_flux() ){ return 1; }
+
+	return 0;
+}
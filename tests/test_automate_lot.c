@@ -0,0 +1,180 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "automate_lot.h"
+#include "rationnel.h"
+#include "outils.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+static int est_reconnu( const uint64_t* resultats, size_t i ){
+	return ( resultats[ i / 64 ] >> ( i % 64 ) ) & 1;
+}
+
+int test_automate_lot(){
+	int result = 1;
+
+	{
+		Rationnel * rat = expression_to_rationnel( "(a+b)*.a.(a+b).b" );
+		Automate * automate = Glushkov( rat );
+		Automate_compile * compile = compiler_automate( automate );
+
+		// Des mots aléatoires sur {a, b, c}, en nombre qui n'est pas un 
+		// multiple de la taille des tranches.
+		size_t nb_mots = 3 * AUTOMATE_LOT_MOTS_PAR_TRANCHE + 17;
+		size_t nb_resultats = ( nb_mots + 63 ) / 64;
+		char* textes = xmalloc( nb_mots * 13 );
+		Mot* mots = xmalloc( nb_mots * sizeof(Mot) );
+		size_t i;
+		srand( 42 );
+		for( i = 0; i < nb_mots; i++ ){
+			char* texte = textes + i * 13;
+			int longueur = rand() % 12, j;
+			for( j = 0; j < longueur; j++ ){
+				texte[j] = "aab"[ rand() % 3 ] + ( rand() % 50 == 0 ? 2 : 0 );
+			}
+			texte[longueur] = '\0';
+			mots[i].octets = texte;
+			mots[i].longueur = longueur;
+		}
+
+		uint64_t* resultats = xmalloc( nb_resultats * sizeof(uint64_t) );
+		int nb_fils[] = { 1, 2, 3, 0 };
+		int f;
+		for( f = 0; f < sizeof(nb_fils)/sizeof(nb_fils[0]); f++ ){
+			memset( resultats, 0xff, nb_resultats * sizeof(uint64_t) );
+			reconnaitre_lot_compile( compile, mots, nb_mots, resultats, nb_fils[f] );
+			int meme = 1, nb_reconnus = 0;
+			for( i = 0; i < nb_mots; i++ ){
+				meme &= est_reconnu( resultats, i ) == 
+					le_mot_est_reconnu( automate, mots[i].octets );
+				nb_reconnus += est_reconnu( resultats, i );
+			}
+			TEST(
+				1
+				&& meme
+				&& nb_reconnus > 0
+				&& nb_reconnus < nb_mots
+				&& resultats[ nb_resultats - 1 ] >> ( nb_mots % 64 ) == 0
+				, result
+			);
+		}
+
+		// Avancer plusieurs mots à la fois ne change pas les résultats.
+		uint64_t* entrelaces = xmalloc( nb_resultats * sizeof(uint64_t) );
+		int nb_flux[] = { 1, 4, 7, AUTOMATE_LOT_MAX_FLUX };
+		for( f = 0; f < sizeof(nb_flux)/sizeof(nb_flux[0]); f++ ){
+			memset( entrelaces, 0xff, nb_resultats * sizeof(uint64_t) );
+			reconnaitre_mots_entrelaces( 
+				compile, mots, nb_mots, entrelaces, nb_flux[f] 
+			);
+			TEST(
+				1
+				&& memcmp( 
+					entrelaces, resultats, nb_resultats * sizeof(uint64_t) 
+				) == 0
+				, result
+			);
+		}
+		xfree( entrelaces );
+
+		// Un lot vide n'écrit rien.
+		resultats[0] = 12345;
+		reconnaitre_lot_compile( compile, mots, 0, resultats, 4 );
+		TEST(
+			1
+			&& resultats[0] == 12345
+			, result
+		);
+
+		xfree( resultats );
+		xfree( mots );
+		xfree( textes );
+		liberer_automate_compile( compile );
+		liberer_automate( automate );
+	}
+
+	{
+		// Des mots de longueurs très différentes, dont certains atteignent 
+		// le puits bien avant leur fin.
+		Rationnel * rat = expression_to_rationnel( "a*.b" );
+		Automate * automate = Glushkov( rat );
+		Automate_compile * compile = compiler_automate( automate );
+		size_t nb_mots = 100, i;
+		char* textes = xmalloc( nb_mots * 301 );
+		Mot* mots = xmalloc( nb_mots * sizeof(Mot) );
+		for( i = 0; i < nb_mots; i++ ){
+			char* texte = textes + i * 301;
+			size_t longueur = ( i * 37 ) % 300, j;
+			for( j = 0; j + 1 < longueur; j++ ) texte[j] = 'a';
+			if( longueur ) texte[ longueur - 1 ] = i % 3 ? 'b' : 'a';
+			if( i % 5 == 0 && longueur > 2 ) texte[1] = 'b';
+			texte[longueur] = '\0';
+			mots[i].octets = texte;
+			mots[i].longueur = longueur;
+		}
+		uint64_t resultats[2];
+		reconnaitre_mots_entrelaces( compile, mots, nb_mots, resultats, 5 );
+		int meme = 1;
+		for( i = 0; i < nb_mots; i++ ){
+			meme &= est_reconnu( resultats, i ) == 
+				le_mot_est_reconnu( automate, mots[i].octets );
+		}
+		TEST(
+			1
+			&& meme
+			, result
+		);
+		xfree( mots );
+		xfree( textes );
+		liberer_automate_compile( compile );
+		liberer_automate( automate );
+	}
+
+	{
+		// Les mots peuvent contenir des octets nuls.
+		Automate * automate = creer_automate();
+		ajouter_etat_initial( automate, 0 );
+		ajouter_transition( automate, 0, '\0', 1 );
+		ajouter_transition( automate, 1, 'a', 1 );
+		ajouter_etat_final( automate, 1 );
+		Automate_compile * compile = compiler_automate( automate );
+		Mot mots[] = { { "\0aa", 3 }, { "aa", 2 }, { "", 0 }, { "\0", 1 } };
+		uint64_t resultats[1];
+		reconnaitre_lot_compile( compile, mots, 4, resultats, 2 );
+		TEST(
+			1
+			&& resultats[0] == 9
+			, result
+		);
+		liberer_automate_compile( compile );
+		liberer_automate( automate );
+	}
+
+	return result;
+}
+
+int main(){
+
+	if( ! test_automate_lot() ){ return 1; }
+
+	return 0;
+}
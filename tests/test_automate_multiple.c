@@ -0,0 +1,102 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "automate_multiple.h"
+#include "rationnel.h"
+#include "outils.h"
+
+#include <string.h>
+
+#define NB_MOTIFS 5
+
+int test_automate_multiple(){
+	int result = 1;
+
+	{
+		const char* expressions[NB_MOTIFS] = {
+			"a.b*", "(a+b)*.b", "a*", "c.(a+b)*", "a.b"
+		};
+		Rationnel* motifs[NB_MOTIFS];
+		Automate* glushkov[NB_MOTIFS];
+		int i;
+		for( i = 0; i < NB_MOTIFS; i++ ){
+			motifs[i] = expression_to_rationnel( expressions[i] );
+			glushkov[i] = Glushkov( motifs[i] );
+		}
+		Automate_multiple* multiple = creer_automate_multiple( motifs, NB_MOTIFS );
+
+		// Tous les mots de longueur au plus 6 sur {a, b, c, d}.
+		const char lettres[] = "abcd";
+		char mot[7];
+		int longueur, code, max, correct = 1;
+		for( longueur = 0; longueur <= 6; longueur++ ){
+			for( max = 1, i = 0; i < longueur; i++ ) max *= 4;
+			for( code = 0; code < max; code++ ){
+				int reste = code;
+				for( i = 0; i < longueur; i++ ){
+					mot[i] = lettres[ reste % 4 ];
+					reste /= 4;
+				}
+				mot[longueur] = '\0';
+
+				const int* reconnus;
+				int nb = motifs_reconnus( multiple, mot, longueur, &reconnus );
+				int j = 0;
+				for( i = 0; i < NB_MOTIFS; i++ ){
+					if( le_mot_est_reconnu( glushkov[i], mot ) ){
+						correct &= j < nb && reconnus[j] == i;
+						j++;
+					}
+				}
+				correct &= j == nb;
+			}
+		}
+
+		const int* reconnus;
+		int nb_ab = motifs_reconnus( multiple, "ab", 2, &reconnus );
+		int ab = nb_ab == 3 && reconnus[0] == 0 && reconnus[1] == 1 && reconnus[2] == 4;
+		int nb_vide = motifs_reconnus( multiple, "", 0, &reconnus );
+		int vide = nb_vide == 1 && reconnus[0] == 2;
+
+		TEST(
+			1
+			&& multiple->nb_motifs == NB_MOTIFS
+			&& correct
+			&& ab
+			&& vide
+			&& motifs_reconnus( multiple, "dab", 3, &reconnus ) == 0
+			, result
+		);
+
+		liberer_automate_multiple( multiple );
+		for( i = 0; i < NB_MOTIFS; i++ ){
+			liberer_automate( glushkov[i] );
+		}
+	}
+
+	return result;
+}
+
+int main(){
+
+	if( ! test_automate_multiple() ){ return 1; }
+
+	return 0;
+}
@@ -0,0 +1,164 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "automate_parallele.h"
+#include "rationnel.h"
+#include "outils.h"
+
+/*
+ * Deux automates sont identiques s'ils ont les mêmes états, les mêmes 
+ * lettres et les mêmes transitions, numéros compris.
+ */
+static int automates_identiques( const Automate* a1, const Automate* a2 ){
+	if( 
+		comparer_ensemble( get_etats( a1 ), get_etats( a2 ) )
+		|| comparer_ensemble( get_alphabet( a1 ), get_alphabet( a2 ) )
+		|| comparer_ensemble( get_initiaux( a1 ), get_initiaux( a2 ) )
+		|| comparer_ensemble( get_finaux( a1 ), get_finaux( a2 ) )
+	){
+		return 0;
+	}
+	Ensemble_iterateur it_etat, it_lettre;
+	for(
+		it_etat = premier_iterateur_ensemble( get_etats( a1 ) );
+		! iterateur_ensemble_est_vide( it_etat );
+		it_etat = iterateur_suivant_ensemble( it_etat )
+	){
+		for(
+			it_lettre = premier_iterateur_ensemble( get_alphabet( a1 ) );
+			! iterateur_ensemble_est_vide( it_lettre );
+			it_lettre = iterateur_suivant_ensemble( it_lettre )
+		){
+			int etat = get_element( it_etat );
+			char lettre = (char) get_element( it_lettre );
+			if( 
+				comparer_ensemble( 
+					voisins( a1, etat, lettre ), voisins( a2, etat, lettre ) 
+				) 
+			){
+				return 0;
+			}
+		}
+	}
+	return 1;
+}
+
+static int meme_determinisation( const Automate* automate ){
+	Automate * sequentiel = creer_automate_deterministe( automate );
+	int nb_fils[] = { 1, 2, 3, 8, 0 };
+	int i, res = 1;
+	for( i = 0; i < sizeof(nb_fils)/sizeof(nb_fils[0]); i++ ){
+		Automate * parallele = 
+			creer_automate_deterministe_parallele( automate, nb_fils[i] );
+		res &= automates_identiques( sequentiel, parallele );
+		liberer_automate( parallele );
+	}
+	liberer_automate( sequentiel );
+	return res;
+}
+
+int test_automate_parallele(){
+	int result = 1;
+
+	{
+		// (a+b)*.a.(a+b)^k : 2^(k+1) sous-ensembles.
+		Automate * automate = creer_automate();
+		int k = 10, i;
+		ajouter_etat_initial( automate, 0 );
+		ajouter_transition( automate, 0, 'a', 0 );
+		ajouter_transition( automate, 0, 'b', 0 );
+		ajouter_transition( automate, 0, 'a', 1 );
+		for( i = 1; i <= k; i++ ){
+			ajouter_transition( automate, i, 'a', i+1 );
+			ajouter_transition( automate, i, 'b', i+1 );
+		}
+		ajouter_etat_final( automate, k+1 );
+
+		Automate * det = creer_automate_deterministe_parallele( automate, 4 );
+		TEST(
+			1
+			&& taille_ensemble( get_etats( det ) ) == 1 << ( k+1 )
+			&& meme_determinisation( automate )
+			, result
+		);
+		liberer_automate( det );
+		liberer_automate( automate );
+	}
+
+	{
+		const char* expressions[] = {
+			"a", "a.b*", "(a+b)*.a.(a+b)", "(a.b+c)*.c", "a*.b*.c*",
+			"(a+b+c+d)*.a.b.(c+d)*"
+		};
+		int i;
+		for( i = 0; i < sizeof(expressions)/sizeof(expressions[0]); i++ ){
+			Rationnel * rat = expression_to_rationnel( expressions[i] );
+			Automate * automate = Glushkov( rat );
+			TEST(
+				1
+				&& meme_determinisation( automate )
+				, result
+			);
+			liberer_automate( automate );
+		}
+	}
+
+	{
+		// États éloignés, plusieurs états initiaux, états sans transition.
+		Automate * automate = creer_automate();
+		ajouter_etat_initial( automate, 5 );
+		ajouter_etat_initial( automate, 1000000 );
+		ajouter_transition( automate, 5, 'x', 1000000 );
+		ajouter_transition( automate, 1000000, 'x', 5 );
+		ajouter_transition( automate, 1000000, 'y', 77 );
+		ajouter_etat( automate, 3 );
+		ajouter_etat_final( automate, 77 );
+		TEST(
+			1
+			&& meme_determinisation( automate )
+			, result
+		);
+		liberer_automate( automate );
+	}
+
+	{
+		// Sans état initial, le seul état est l'ensemble vide.
+		Automate * automate = creer_automate();
+		ajouter_transition( automate, 0, 'a', 1 );
+		Automate * det = creer_automate_deterministe_parallele( automate, 2 );
+		TEST(
+			1
+			&& taille_ensemble( get_etats( det ) ) == 1
+			&& meme_determinisation( automate )
+			, result
+		);
+		liberer_automate( det );
+		liberer_automate( automate );
+	}
+
+	return result;
+}
+
+int main(){
+
+	if( ! test_automate_parallele() ){ return 1; }
+
+	return 0;
+}
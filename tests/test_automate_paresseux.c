@@ -0,0 +1,121 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "automate_paresseux.h"
+#include "rationnel.h"
+#include "outils.h"
+
+#include <string.h>
+
+/*
+ * Compare l'automate paresseux et le_mot_est_reconnu() sur 'nb_mots' mots 
+ * aléatoires de longueur au plus 'longueur_max' sur l'alphabet {a, b, c}.
+ */
+int meme_reconnaissance( 
+	const Automate* automate, Automate_paresseux* paresseux, 
+	int nb_mots, int longueur_max
+){
+	char mot[64];
+	int n, i;
+	for( n = 0; n < nb_mots; n++ ){
+		int longueur = rand() % ( longueur_max + 1 );
+		for( i = 0; i < longueur; i++ ){
+			mot[i] = 'a' + rand() % 3;
+		}
+		mot[longueur] = '\0';
+		if( 
+			le_mot_est_reconnu( automate, mot ) != 
+			le_mot_est_reconnu_paresseux( paresseux, mot, longueur )
+		){
+			return 0;
+		}
+	}
+	return 1;
+}
+
+int test_automate_paresseux(){
+	int result = 1;
+	srand( 42 );
+
+	{
+		Automate * automate = creer_automate();
+		ajouter_etat_initial( automate, 0 );
+		ajouter_transition( automate, 0, 'a', 0 );
+		ajouter_transition( automate, 0, 'b', 0 );
+		ajouter_transition( automate, 0, 'a', 1 );
+		ajouter_transition( automate, 1, 'b', 2 );
+		ajouter_etat_final( automate, 2 );
+
+		Automate_paresseux * paresseux = creer_automate_paresseux( automate, 16 );
+		int r1 = le_mot_est_reconnu_paresseux( paresseux, "abab", 4 );
+		int r2 = le_mot_est_reconnu_paresseux( paresseux, "aba", 3 );
+		int r3 = le_mot_est_reconnu_paresseux( paresseux, "abc", 3 );
+		int r4 = le_mot_est_reconnu_paresseux( paresseux, "ab\0b", 4 );
+		long echecs = paresseux->nb_echecs;
+		int r5 = le_mot_est_reconnu_paresseux( paresseux, "abab", 4 );
+
+		TEST(
+			1
+			&& r1 && ! r2 && ! r3 && ! r4 && r5
+			&& paresseux->nb_echecs == echecs
+			&& paresseux->nb_succes >= 4
+			&& paresseux->nb_vidages == 0
+			, result
+		);
+
+		liberer_automate_paresseux( paresseux );
+		liberer_automate( automate );
+	}
+
+	{
+		// Le déterminisé de cet automate a 2^11 états.
+		Rationnel * rat = expression_to_rationnel( 
+			"(a+b+c)*.a.(a+b).(a+b).(a+b).(a+b).(a+b).(a+b).(a+b).(a+b).(a+b).(a+b)"
+		);
+		Automate * automate = Glushkov( rat );
+
+		Automate_paresseux * grand = creer_automate_paresseux( automate, 4096 );
+		Automate_paresseux * petit = creer_automate_paresseux( automate, 8 );
+
+		TEST(
+			1
+			&& meme_reconnaissance( automate, grand, 500, 40 )
+			&& meme_reconnaissance( automate, petit, 500, 40 )
+			&& grand->nb_vidages == 0
+			&& grand->nb_succes > 0
+			&& petit->nb_vidages > 0
+			&& petit->nb_replis > 0
+			, result
+		);
+
+		liberer_automate_paresseux( petit );
+		liberer_automate_paresseux( grand );
+		liberer_automate( automate );
+	}
+
+	return result;
+}
+
+int main(){
+
+	if( ! test_automate_paresseux() ){ return 1; }
+
+	return 0;
+}
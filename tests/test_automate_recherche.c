@@ -0,0 +1,209 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "automate_recherche.h"
+#include "rationnel.h"
+#include "outils.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_OCCURRENCES 4096
+
+typedef struct {
+	int nb;
+	size_t debuts[MAX_OCCURRENCES];
+	size_t fins[MAX_OCCURRENCES];
+} Occurrences;
+
+void noter_occurrence( size_t debut, size_t fin, void* data ){
+	Occurrences* occ = (Occurrences*) data;
+	if( occ->nb < MAX_OCCURRENCES ){
+		occ->debuts[occ->nb] = debut;
+		occ->fins[occ->nb] = fin;
+	}
+	occ->nb++;
+}
+
+int est_une_occurrence( const Automate* automate, const char* texte, size_t debut, size_t fin ){
+	char facteur[64];
+	memcpy( facteur, texte + debut, fin - debut );
+	facteur[ fin - debut ] = '\0';
+	return le_mot_est_reconnu( automate, facteur );
+}
+
+// Les occurrences, dans l'ordre de pour_toute_occurrence().
+void toutes_les_occurrences(
+	const Automate* automate, const char* texte, size_t longueur, Occurrences* occ
+){
+	size_t debut, fin;
+	occ->nb = 0;
+	for( fin = 0; fin <= longueur; fin++ ){
+		for( debut = fin + 1; debut-- > 0; ){
+			if( est_une_occurrence( automate, texte, debut, fin ) ){
+				noter_occurrence( debut, fin, occ );
+			}
+		}
+	}
+}
+
+// Les occurrences, dans l'ordre de pour_toute_occurrence_la_plus_longue().
+void occurrences_les_plus_longues(
+	const Automate* automate, const char* texte, size_t longueur, Occurrences* occ
+){
+	size_t position = 0, debut, fin;
+	occ->nb = 0;
+	for( debut = position; debut <= longueur; debut++ ){
+		if( debut < position ) continue;
+		int trouve = 0;
+		size_t plus_longue = 0;
+		for( fin = debut; fin <= longueur; fin++ ){
+			if( est_une_occurrence( automate, texte, debut, fin ) ){
+				trouve = 1;
+				plus_longue = fin;
+			}
+		}
+		if( trouve ){
+			noter_occurrence( debut, plus_longue, occ );
+			position = ( plus_longue > debut ) ? plus_longue : debut + 1;
+		}
+	}
+}
+
+int memes_occurrences( const Occurrences* a, const Occurrences* b ){
+	int i;
+	if( a->nb != b->nb ) return 0;
+	for( i = 0; i < a->nb && i < MAX_OCCURRENCES; i++ ){
+		if( a->debuts[i] != b->debuts[i] || a->fins[i] != b->fins[i] ) return 0;
+	}
+	return 1;
+}
+
+int test_automate_recherche(){
+	int result = 1;
+
+	{
+		Automate* automate = Glushkov( expression_to_rationnel( "a.b*" ) );
+		Automate_recherche* recherche = creer_automate_recherche( automate );
+		const char* texte = "xabbzab";
+		Occurrences toutes, longues;
+		toutes.nb = 0;
+		longues.nb = 0;
+		pour_toute_occurrence( recherche, texte, 7, noter_occurrence, &toutes );
+		pour_toute_occurrence_la_plus_longue( recherche, texte, 7, noter_occurrence, &longues );
+
+		TEST(
+			1
+			&& toutes.nb == 5
+			&& toutes.debuts[0] == 1 && toutes.fins[0] == 2
+			&& toutes.debuts[2] == 1 && toutes.fins[2] == 4
+			&& toutes.debuts[4] == 5 && toutes.fins[4] == 7
+			&& longues.nb == 2
+			&& longues.debuts[0] == 1 && longues.fins[0] == 4
+			&& longues.debuts[1] == 5 && longues.fins[1] == 7
+			, result
+		);
+		liberer_automate_recherche( recherche );
+		liberer_automate( automate );
+	}
+
+	{
+		// Comparaison avec une recherche naïve, sur des textes aléatoires.
+		const char* expressions[] = {
+			"a.b*", "(a+b)*.b", "a*", "a.b.c+b.c", "(a.b)*.c", "b.b+a.(a+b+c)*.a"
+		};
+		const char lettres[] = "abcx";
+		int nb_expressions = sizeof(expressions) / sizeof(char*);
+		int i, j, correct = 1;
+		srand( 2015 );
+		for( i = 0; i < nb_expressions; i++ ){
+			Automate* automate = Glushkov( expression_to_rationnel( expressions[i] ) );
+			Automate_recherche* recherche = creer_automate_recherche( automate );
+			for( j = 0; j < 100; j++ ){
+				char texte[48];
+				size_t longueur = rand() % 40, k;
+				for( k = 0; k < longueur; k++ ){
+					texte[k] = lettres[ rand() % 4 ];
+				}
+				texte[longueur] = '\0';
+
+				Occurrences attendues, obtenues;
+				toutes_les_occurrences( automate, texte, longueur, &attendues );
+				obtenues.nb = 0;
+				pour_toute_occurrence( recherche, texte, longueur, noter_occurrence, &obtenues );
+				correct &= memes_occurrences( &attendues, &obtenues );
+
+				occurrences_les_plus_longues( automate, texte, longueur, &attendues );
+				obtenues.nb = 0;
+				pour_toute_occurrence_la_plus_longue(
+					recherche, texte, longueur, noter_occurrence, &obtenues
+				);
+				correct &= memes_occurrences( &attendues, &obtenues );
+			}
+			liberer_automate_recherche( recherche );
+			liberer_automate( automate );
+		}
+
+		TEST(
+			1
+			&& correct
+			, result
+		);
+	}
+
+	{
+		// Un long texte, avec des octets nuls, est lu sans relancer 
+		// l'automate depuis chaque position.
+		Automate* automate = Glushkov( expression_to_rationnel( "a.b.c" ) );
+		Automate_recherche* recherche = creer_automate_recherche( automate );
+		size_t longueur = 1000000, k;
+		char* texte = xmalloc( longueur );
+		memset( texte, '\0', longueur );
+		for( k = 0; k + 3 <= longueur; k += 1000 ){
+			memcpy( texte + k + 500, "abc", 3 );
+		}
+		Occurrences toutes, longues;
+		toutes.nb = 0;
+		longues.nb = 0;
+		pour_toute_occurrence( recherche, texte, longueur, noter_occurrence, &toutes );
+		pour_toute_occurrence_la_plus_longue( recherche, texte, longueur, noter_occurrence, &longues );
+
+		TEST(
+			1
+			&& toutes.nb == 1000
+			&& longues.nb == 1000
+			&& longues.debuts[999] == 999500
+			&& longues.fins[999] == 999503
+			, result
+		);
+		xfree( texte );
+		liberer_automate_recherche( recherche );
+		liberer_automate( automate );
+	}
+
+	return result;
+}
+
+int main(){
+
+	if( ! test_automate_recherche() ){ return 1; }
+
+	return 0;
+}
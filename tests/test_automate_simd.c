@@ -0,0 +1,167 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "automate_simd.h"
+#include "rationnel.h"
+#include "outils.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+int test_automate_simd(){
+	int result = 1;
+
+	{
+		const char* expressions[] = {
+			"a", "a.b*", "(a+b)*.a.(a+b)", "(a.b+c)*.c", "a*.b*.c*",
+			"(a+b+c)*.a.b.a", "(a+b)*", "((a+b).(a+b+c))*"
+		};
+		int i;
+		srand( 3 );
+		for( i = 0; i < sizeof(expressions)/sizeof(expressions[0]); i++ ){
+			Rationnel * rat = expression_to_rationnel( expressions[i] );
+			Automate * automate = Glushkov( rat );
+			Automate * minimal = creer_automate_minimal( automate );
+			Automate_simd * simd = creer_automate_simd( minimal );
+
+			// Des mots aléatoires, dont certains plus longs qu'un bloc et 
+			// certains avec une lettre hors de l'alphabet.
+			int meme = simd != NULL, n;
+			char mot[200];
+			for( n = 0; simd && n < 2000; n++ ){
+				int longueur = n % 10 == 0 ? rand() % 199 : rand() % 12, j;
+				for( j = 0; j < longueur; j++ ){
+					mot[j] = "aabbcc"[ rand() % 6 ] + ( rand() % 200 == 0 ? 3 : 0 );
+				}
+				mot[longueur] = '\0';
+				int attendu = le_mot_est_reconnu( minimal, mot );
+				meme &= le_mot_est_reconnu_simd( simd, mot, longueur ) == attendu;
+				meme &= le_mot_est_reconnu_simd_scalaire( simd, mot, longueur ) == attendu;
+			}
+			TEST(
+				1
+				&& meme
+				&& simd->nb_etats <= AUTOMATE_SIMD_MAX_ETATS
+				, result
+			);
+
+			liberer_automate_simd( simd );
+			liberer_automate( minimal );
+			liberer_automate( automate );
+		}
+	}
+
+	{
+		// Un mot très long qui reste hors du puits, puis qui y tombe.
+		Rationnel * rat = expression_to_rationnel( "(a.b)*" );
+		Automate * automate = Glushkov( rat );
+		Automate * minimal = creer_automate_minimal( automate );
+		Automate_simd * simd = creer_automate_simd( minimal );
+		size_t longueur = 10000, i;
+		char* mot = xmalloc( longueur );
+		for( i = 0; i < longueur; i++ ) mot[i] = i % 2 ? 'b' : 'a';
+		int reconnu = le_mot_est_reconnu_simd( simd, mot, longueur );
+		int impair = le_mot_est_reconnu_simd( simd, mot, longueur - 1 );
+		mot[5000] = 'b';
+		int rejete = le_mot_est_reconnu_simd( simd, mot, longueur );
+		TEST(
+			1
+			&& reconnu
+			&& ! impair
+			&& ! rejete
+			, result
+		);
+		xfree( mot );
+		liberer_automate_simd( simd );
+		liberer_automate( minimal );
+		liberer_automate( automate );
+	}
+
+	{
+		// Le minimal de (a+b)*.a.(a+b)^4 a 32 états : trop pour 16.
+		Rationnel * rat = expression_to_rationnel( 
+			"(a+b)*.a.(a+b).(a+b).(a+b).(a+b)" 
+		);
+		Automate * automate = Glushkov( rat );
+		Automate * minimal = creer_automate_minimal( automate );
+		TEST(
+			1
+			&& creer_automate_simd( minimal ) == NULL
+			, result
+		);
+		liberer_automate( minimal );
+		liberer_automate( automate );
+	}
+
+	{
+		// Un compteur modulo 16 n'a pas d'état mort : ses 16 états tiennent 
+		// sans puits, et les octets hors de l'alphabet sont quand même 
+		// rejetés, y compris après plusieurs blocs.
+		Automate * automate = creer_automate();
+		int q;
+		for( q = 0; q < 16; q++ ){
+			ajouter_transition( automate, q, 'a', ( q + 1 ) % 16 );
+			ajouter_transition( automate, q, 'b', q );
+		}
+		ajouter_etat_initial( automate, 0 );
+		ajouter_etat_final( automate, 0 );
+		Automate * minimal = creer_automate_minimal( automate );
+		Automate_simd * simd = creer_automate_simd( minimal );
+
+		int meme = simd != NULL, n;
+		char mot[300];
+		srand( 5 );
+		for( n = 0; simd && n < 2000; n++ ){
+			int longueur = n % 10 == 0 ? rand() % 299 : rand() % 40, j;
+			for( j = 0; j < longueur; j++ ){
+				mot[j] = "aaab"[ rand() % 4 ] + ( rand() % 300 == 0 ? 2 : 0 );
+			}
+			mot[longueur] = '\0';
+			int attendu = le_mot_est_reconnu( minimal, mot );
+			meme &= le_mot_est_reconnu_simd( simd, mot, longueur ) == attendu;
+			meme &= le_mot_est_reconnu_simd_scalaire( simd, mot, longueur ) == attendu;
+		}
+		for( n = 0; n < 160; n++ ) mot[n] = 'a';
+		int reconnu = simd && le_mot_est_reconnu_simd( simd, mot, 160 );
+		mot[100] = 'z';
+		int rejete = simd && ! le_mot_est_reconnu_simd( simd, mot, 160 );
+		TEST(
+			1
+			&& meme
+			&& simd->nb_etats == 16
+			&& simd->puits == -1
+			&& reconnu
+			&& rejete
+			, result
+		);
+		liberer_automate_simd( simd );
+		liberer_automate( minimal );
+		liberer_automate( automate );
+	}
+
+	return result;
+}
+
+int main(){
+
+	if( ! test_automate_simd() ){ return 1; }
+
+	return 0;
+}
@@ -0,0 +1,199 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "automate.h"
+#include "automate_compile.h"
+#include "automate_paresseux.h"
+#include "automate_parallele.h"
+#include "rationnel.h"
+#include "outils.h"
+
+#include <string.h>
+
+int test_classes_lettres(){
+	int result = 1;
+
+	{
+		Automate * automate = creer_automate();
+		ajouter_transition( automate, 0, 'a', 1 );
+		ajouter_transition( automate, 0, 'b', 1 );
+		ajouter_transition( automate, 0, 'c', 1 );
+		ajouter_transition( automate, 1, 'd', 0 );
+		ajouter_lettre( automate, 'e' );
+		ajouter_etat_final( automate, 1 );
+
+		uint16_t classes[256];
+		char representants[257];
+		int nb = classes_de_lettres( automate, classes, representants );
+
+		TEST(
+			1
+			&& nb == 4
+			&& classes['a'] == 1
+			&& classes['b'] == 1
+			&& classes['c'] == 1
+			&& classes['d'] == 2
+			&& classes['e'] == 3
+			&& classes['z'] == 0
+			&& representants[1] == 'a'
+			&& representants[2] == 'd'
+			&& representants[3] == 'e'
+			, result
+		);
+
+		// Une lettre qui manque dans un seul état sépare la classe.
+		ajouter_transition( automate, 1, 'a', 1 );
+		nb = classes_de_lettres( automate, classes, NULL );
+		TEST(
+			1
+			&& nb == 5
+			&& classes['a'] != classes['b']
+			&& classes['b'] == classes['c']
+			, result
+		);
+		liberer_automate( automate );
+	}
+
+	{
+		// Les classes communes séparent les lettres distinguées par l'un
+		// des deux automates.
+		Automate * automate_1 = creer_automate();
+		Automate * automate_2 = creer_automate();
+		ajouter_transition( automate_1, 0, 'a', 1 );
+		ajouter_transition( automate_1, 0, 'b', 1 );
+		ajouter_transition( automate_2, 0, 'a', 1 );
+		ajouter_transition( automate_2, 0, 'b', 2 );
+		ajouter_transition( automate_2, 0, 'c', 2 );
+		uint16_t classes_1[256], classes[256];
+		int nb_1 = classes_de_lettres( automate_1, classes_1, NULL );
+		int nb = classes_de_lettres_communes( 
+			automate_1, automate_2, classes, NULL 
+		);
+		TEST(
+			1
+			&& nb_1 == 2
+			&& classes_1['a'] == classes_1['b']
+			&& nb == 4
+			&& classes['a'] != classes['b']
+			&& classes['c'] != classes['b']
+			, result
+		);
+		liberer_automate( automate_1 );
+		liberer_automate( automate_2 );
+	}
+
+	{
+		// L'automate compilé n'a qu'une colonne par classe.
+		Rationnel * rat = expression_to_rationnel( "(a+b+c+d)*.e.(f+g)" );
+		Automate * automate = Glushkov( rat );
+		Automate * minimal = creer_automate_minimal( automate );
+		Automate_compile * compile = compiler_automate( minimal );
+		const char* mots[] = { "", "e", "ef", "abcdeg", "dcbaef", "eff", "aef" };
+		int i, meme = 1;
+		for( i = 0; i < sizeof(mots)/sizeof(mots[0]); i++ ){
+			meme &= le_mot_est_reconnu( automate, mots[i] ) == 
+				le_mot_est_reconnu_compile( compile, mots[i], strlen( mots[i] ) );
+		}
+		TEST(
+			1
+			&& compile->nb_classes == 4
+			&& compile->classes['a'] == compile->classes['d']
+			&& compile->classes['f'] == compile->classes['g']
+			&& compile->classes['e'] != compile->classes['a']
+			&& meme
+			, result
+		);
+		liberer_automate_compile( compile );
+		liberer_automate( minimal );
+		liberer_automate( automate );
+	}
+
+	{
+		// Les 256 octets sont des lettres deux à deux distinctes : il y a 
+		// 256 classes de lettres en plus de la classe 0. L'automate 
+		// reconnaît les mots de deux octets identiques.
+		Automate * automate = creer_automate();
+		int o;
+		for( o = 0; o < 256; o++ ){
+			ajouter_transition( automate, 0, (char) o, o + 1 );
+			ajouter_transition( automate, o + 1, (char) o, 300 );
+		}
+		ajouter_etat_initial( automate, 0 );
+		ajouter_etat_final( automate, 300 );
+
+		uint16_t classes[256];
+		char representants[257];
+		int nb = classes_de_lettres( automate, classes, representants );
+		int distinctes = 1;
+		int vues[257] = { 0 };
+		for( o = 0; o < 256; o++ ){
+			distinctes &= classes[o] >= 1 && classes[o] <= 256
+				&& ! vues[ classes[o] ]++
+				&& representants[ classes[o] ] == (char) o;
+		}
+		int nb_communes = classes_de_lettres_communes( 
+			automate, automate, classes, NULL 
+		);
+
+		Automate * deterministe = creer_automate_deterministe( automate );
+		Automate * parallele = creer_automate_deterministe_parallele( 
+			automate, 4 
+		);
+		Automate * minimal = creer_automate_minimal_hopcroft( automate );
+		Automate * produit = creer_intersection_des_automates( 
+			automate, minimal 
+		);
+		Automate_paresseux * paresseux = creer_automate_paresseux( 
+			automate, 16 
+		);
+		TEST(
+			1
+			&& nb == 257
+			&& distinctes
+			&& nb_communes == 257
+			&& taille_ensemble( get_etats( deterministe ) ) == 259
+			&& taille_ensemble( get_etats( parallele ) ) == 259
+			&& taille_ensemble( get_etats( minimal ) ) == 259
+			&& taille_ensemble( get_etats( produit ) ) == 258
+			&& le_mot_est_reconnu( minimal, "\377\377" )
+			&& ! le_mot_est_reconnu( minimal, "\377\376" )
+			&& le_mot_est_reconnu( produit, "\001\001" )
+			&& le_mot_est_reconnu_paresseux( paresseux, "\0\0", 2 )
+			&& ! le_mot_est_reconnu_paresseux( paresseux, "\0\377", 2 )
+			&& le_mot_est_reconnu_paresseux( paresseux, "\377\377", 2 )
+			, result
+		);
+		liberer_automate_paresseux( paresseux );
+		liberer_automate( produit );
+		liberer_automate( minimal );
+		liberer_automate( parallele );
+		liberer_automate( deterministe );
+		liberer_automate( automate );
+	}
+
+	return result;
+}
+
+int main(){
+
+	if( ! test_classes_lettres() ){ return 1; }
+
+	return 0;
+}
@@ -86,6 +86,32 @@ int test_transitions_automate( int nb_transitions, const Automate* aut, ... ){
 	return 1;
 }
 
+typedef struct {
+	const Automate* autre;
+	int identiques;
+} data_automates_identiques;
+
+void action_automates_identiques(
+	int origine, char lettre, int fin, void* data
+){
+	data_automates_identiques* d = (data_automates_identiques*) data;
+	d->identiques &= est_une_transition_de_l_automate(
+		d->autre, origine, lettre, fin
+	);
+}
+
+int automates_identiques( const Automate* a1, const Automate* a2 ){
+	if(
+		comparer_ensemble( get_etats( a1 ), get_etats( a2 ) ) ||
+		comparer_ensemble( get_initiaux( a1 ), get_initiaux( a2 ) ) ||
+		comparer_ensemble( get_finaux( a1 ), get_finaux( a2 ) ) ||
+		nombre_de_transitions( a1 ) != nombre_de_transitions( a2 )
+	){ return 0; }
+	data_automates_identiques data = { a2, 1 };
+	pour_toute_transition( a1, action_automates_identiques, &data );
+	return data.identiques;
+}
+
 int test_creer_automate_minimal(){
 	int resultat = 1;
 	{
@@ -154,6 +180,82 @@ int test_creer_automate_minimal(){
 		liberer_automate( automate );
 	}
 
+	{
+		// Automate déterministe : l'algorithme de Hopcroft est utilisé.
+		Automate* automate = creer_automate();
+		Automate* minimal;		
+
+		ajouter_etat_initial( automate, 0 );
+		ajouter_etat_final( automate, 2 );
+		ajouter_etat_final( automate, 3 );
+		ajouter_transition( automate, 0, 'a', 2 );
+		ajouter_transition( automate, 0, 'b', 1 );
+		ajouter_transition( automate, 1, 'a', 3 );
+		ajouter_transition( automate, 1, 'b', 0 );
+		ajouter_transition( automate, 2, 'a', 2 );
+		ajouter_transition( automate, 2, 'b', 3 );
+		ajouter_transition( automate, 3, 'a', 2 );
+		ajouter_transition( automate, 3, 'b', 3 );
+		ajouter_transition( automate, 7, 'a', 1 );
+
+		minimal = creer_automate_minimal( automate );
+		Automate* brzozowski = creer_automate_minimal_brzozowski( automate );
+
+		TEST(
+			1
+			&& est_deterministe( automate )
+			&& l_ensemble_est_egal( 2, get_etats( minimal ), 0, 1 )
+			&& l_ensemble_est_egal( 1, get_initiaux( minimal ), 0 )
+			&& l_ensemble_est_egal( 1, get_finaux( minimal ), 1 )
+			&& test_transitions_automate( 
+				4, minimal,
+				0, 'a', 1, 
+				0, 'b', 0, 
+				1, 'a', 1, 
+				1, 'b', 1 
+			)
+			&& automates_identiques( minimal, brzozowski ),
+			resultat
+		);	
+
+		liberer_automate( brzozowski );
+		liberer_automate( minimal );
+		liberer_automate( automate );
+	}
+
+	{
+		// Les deux algorithmes donnent le même automate, numéroté de la
+		// même façon, sur des automates déterministes (incomplets) 
+		// pseudo-aléatoires.
+		int graine, ok = 1;
+		srand( 42 );
+		for( graine = 0; graine < 50; graine++ ){
+			Automate* automate = creer_automate();
+			int n = 2 + rand() % 12;
+			int q;
+			ajouter_etat_initial( automate, 0 );
+			for( q = 0; q < n; q++ ){
+				char lettre;
+				for( lettre = 'a'; lettre <= 'c'; lettre++ ){
+					if( rand() % 5 ){
+						ajouter_transition( automate, q, lettre, rand() % n );
+					}
+				}
+				if( rand() % 3 == 0 ){
+					ajouter_etat_final( automate, q );
+				}
+			}
+			Automate* hopcroft = creer_automate_minimal_hopcroft( automate );
+			Automate* brzozowski = creer_automate_minimal_brzozowski( automate );
+			ok &= automates_identiques( hopcroft, brzozowski );
+			liberer_automate( hopcroft );
+			liberer_automate( brzozowski );
+			liberer_automate( automate );
+		}
+
+		TEST( ok, resultat );
+	}
+
 	return resultat;
 }
 
@@ -0,0 +1,89 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "dictionnaire.h"
+#include "outils.h"
+
+Ensemble * creer_paire( int a, int b ){
+	Ensemble * e = creer_ensemble( NULL, NULL, NULL );
+	ajouter_element( e, a );
+	ajouter_element( e, b );
+	return e;
+}
+
+int test_dictionnaire(){
+	int result = 1;
+
+	{
+		Dictionnaire * d = creer_dictionnaire();
+		int nouveau1, nouveau2, nouveau3;
+		int id1 = identifiant_ensemble( d, creer_paire( 1, 2 ), &nouveau1 );
+		int id2 = identifiant_ensemble( d, creer_paire( 2, 3 ), &nouveau2 );
+		int id3 = identifiant_ensemble( d, creer_paire( 2, 1 ), &nouveau3 );
+
+		Ensemble * cherche = creer_paire( 3, 2 );
+		Ensemble * absent = creer_paire( 3, 4 );
+
+		TEST(
+			1
+			&& id1 == 0 && nouveau1
+			&& id2 == 1 && nouveau2
+			&& id3 == 0 && ! nouveau3
+			&& taille_dictionnaire( d ) == 2
+			&& chercher_dictionnaire( d, cherche ) == 1
+			&& chercher_dictionnaire( d, absent ) == -1
+			&& comparer_ensemble( ensemble_de_identifiant( d, 1 ), cherche ) == 0
+			, result
+		);
+
+		liberer_ensemble( cherche );
+		liberer_ensemble( absent );
+		liberer_dictionnaire( d );
+	}
+
+	{
+		// Beaucoup d'ensembles, pour forcer les agrandissements.
+		Dictionnaire * d = creer_dictionnaire();
+		int i, ok = 1;
+		for( i = 0; i < 5000; i++ ){
+			ok &= identifiant_ensemble( d, creer_paire( i, i+1 ), NULL ) == i;
+		}
+		for( i = 0; i < 5000; i++ ){
+			ok &= identifiant_ensemble( d, creer_paire( i+1, i ), NULL ) == i;
+		}
+
+		TEST(
+			1
+			&& ok
+			&& taille_dictionnaire( d ) == 5000
+			, result
+		);
+		liberer_dictionnaire( d );
+	}
+
+	return result;
+}
+
+int main(){
+
+	if( ! test_dictionnaire() ){ return 1; }
+
+	return 0;
+}
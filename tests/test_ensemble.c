@@ -0,0 +1,199 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ensemble.h"
+#include "outils.h"
+
+int comparer_entier( const intptr_t a, const intptr_t b ){
+	if( a < b ) return -1;
+	if( a > b ) return 1;
+	return 0;
+}
+
+int test_ensemble(){
+	int result = 1;
+
+	{
+		Ensemble * e = creer_ensemble( NULL, NULL, NULL );
+		ajouter_element( e, 3 );
+		ajouter_element( e, 200 );
+		ajouter_element( e, 64 );
+		ajouter_element( e, 3 );
+		retirer_element( e, 1000 );
+
+		Ensemble_iterateur it = premier_iterateur_ensemble( e );
+		int ordre = get_element( it ) == 3;
+		it = iterateur_suivant_ensemble( it );
+		ordre &= get_element( it ) == 64;
+		it = iterateur_suivant_ensemble( it );
+		ordre &= get_element( it ) == 200;
+		it = iterateur_precedent_ensemble( it );
+		ordre &= get_element( it ) == 64;
+		it = iterateur_suivant_ensemble( iterateur_suivant_ensemble( it ) );
+
+		TEST(
+			1
+			&& e->table == NULL
+			&& taille_ensemble( e ) == 3
+			&& est_dans_l_ensemble( e, 64 )
+			&& ! est_dans_l_ensemble( e, 65 )
+			&& ordre
+			&& iterateur_ensemble_est_vide( it )
+			, result
+		);
+		liberer_ensemble( e );
+	}
+
+	{
+		// Les opérations sur les tableaux de bits et sur les tables
+		// donnent les mêmes résultats.
+		Ensemble * b1 = creer_ensemble( NULL, NULL, NULL );
+		Ensemble * b2 = creer_ensemble( NULL, NULL, NULL );
+		Ensemble * t1 = creer_ensemble( comparer_entier, NULL, NULL );
+		Ensemble * t2 = creer_ensemble( comparer_entier, NULL, NULL );
+		int i;
+		for( i = -70; i < 300; i += 3 ){
+			ajouter_element( b1, i );
+			ajouter_element( t1, i );
+		}
+		for( i = 0; i < 500; i += 5 ){
+			ajouter_element( b2, i );
+			ajouter_element( t2, i );
+		}
+		Ensemble * bu = creer_union_ensemble( b1, b2 );
+		Ensemble * tu = creer_union_ensemble( t1, t2 );
+		Ensemble * bd = creer_difference_ensemble( b1, b2 );
+		Ensemble * td = creer_difference_ensemble( t1, t2 );
+		Ensemble * bi = creer_intersection_ensemble( b1, b2 );
+		Ensemble * ti = creer_intersection_ensemble( t1, t2 );
+
+		TEST(
+			1
+			&& bu->table == NULL
+			&& comparer_ensemble( bu, tu ) == 0
+			&& comparer_ensemble( bd, td ) == 0
+			&& comparer_ensemble( bi, ti ) == 0
+			&& taille_ensemble( bu ) == taille_ensemble( tu )
+			&& taille_ensemble( bi ) == taille_ensemble( ti )
+			&& est_dans_l_ensemble( bi, 20 )
+			&& ! est_dans_l_ensemble( bd, 20 )
+			&& est_dans_l_ensemble( bd, -70 )
+			, result
+		);
+
+		liberer_ensemble( b1 ); liberer_ensemble( b2 );
+		liberer_ensemble( t1 ); liberer_ensemble( t2 );
+		liberer_ensemble( bu ); liberer_ensemble( tu );
+		liberer_ensemble( bd ); liberer_ensemble( td );
+		liberer_ensemble( bi ); liberer_ensemble( ti );
+	}
+
+	{
+		// Ordre lexicographique des tuples triés.
+		Ensemble * a = creer_ensemble( NULL, NULL, NULL );
+		Ensemble * b = creer_ensemble( NULL, NULL, NULL );
+		Ensemble * vide = creer_ensemble( NULL, NULL, NULL );
+		ajouter_element( a, 1 ); ajouter_element( a, 5 );
+		ajouter_element( b, 1 ); ajouter_element( b, 7 );
+		int cmp1 = comparer_ensemble( a, b );
+		int cmp2 = comparer_ensemble( b, a );
+		ajouter_element( a, 7 );
+		retirer_element( b, 7 );
+		ajouter_element( b, 5 );
+		int cmp3 = comparer_ensemble( a, b );
+		int cmp4 = comparer_ensemble( vide, b );
+
+		TEST(
+			1
+			&& cmp1 == -1
+			&& cmp2 == 1
+			&& cmp3 == 1
+			&& cmp4 == -1
+			&& comparer_ensemble( vide, vide ) == 0
+			, result
+		);
+		liberer_ensemble( a );
+		liberer_ensemble( b );
+		liberer_ensemble( vide );
+	}
+
+	{
+		// Un élément trop éloigné convertit l'ensemble en table.
+		Ensemble * e = creer_ensemble( NULL, NULL, NULL );
+		Ensemble * f = creer_ensemble( NULL, NULL, NULL );
+		ajouter_element( e, 2 );
+		ajouter_element( e, 10000000 );
+		ajouter_element( f, 10000000 );
+		ajouter_element( f, 2 );
+		retirer_element( f, 10000000 );
+		ajouter_element( f, 10000000 );
+		Ensemble * c = copier_ensemble( e );
+
+		TEST(
+			1
+			&& e->table != NULL
+			&& taille_ensemble( e ) == 2
+			&& est_dans_l_ensemble( e, 10000000 )
+			&& comparer_ensemble( e, f ) == 0
+			&& comparer_ensemble( c, e ) == 0
+			&& hacher_ensemble( e ) == hacher_ensemble( f )
+			, result
+		);
+		liberer_ensemble( c );
+		liberer_ensemble( e );
+		liberer_ensemble( f );
+	}
+
+	{
+		// Le hachage ne dépend pas de la représentation.
+		Ensemble * b = creer_ensemble( NULL, NULL, NULL );
+		Ensemble * t = creer_ensemble( NULL, NULL, NULL );
+		ajouter_element( t, 1 << 30 );
+		retirer_element( t, 1 << 30 );
+		int i;
+		for( i = 0; i < 1000; i += 7 ){
+			ajouter_element( b, i );
+			ajouter_element( t, i );
+		}
+		Ensemble * autre = copier_ensemble( b );
+		retirer_element( autre, 7 );
+
+		TEST(
+			1
+			&& b->table == NULL
+			&& t->table != NULL
+			&& hacher_ensemble( b ) == hacher_ensemble( t )
+			&& hacher_ensemble( b ) != hacher_ensemble( autre )
+			, result
+		);
+		liberer_ensemble( b );
+		liberer_ensemble( t );
+		liberer_ensemble( autre );
+	}
+
+	return result;
+}
+
+int main(){
+
+	if( ! test_ensemble() ){ return 1; }
+
+	return 0;
+}
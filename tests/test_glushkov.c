@@ -203,6 +203,49 @@ int test_glushkov(){
 		liberer_automate( automate2 );
 	}
 
+	{
+		// Une expression avec le mot vide : a.(ε+b).
+		Rationnel * expression = Concat( 
+			Lettre( 'a' ), Union( Epsilon(), Lettre( 'b' ) ) 
+		);
+		Automate * automate = Glushkov( expression );
+
+		TEST( 
+			1
+			&& taille_ensemble( get_etats( automate ) ) == 3
+			&& le_mot_est_reconnu( automate, "a" )
+			&& le_mot_est_reconnu( automate, "ab" )
+			&& ! le_mot_est_reconnu( automate, "b" )
+			&& ! le_mot_est_reconnu( automate, "" )
+			, result
+		);
+
+		liberer_automate( automate );
+	}
+
+	{
+		// Une longue expression (a.b*)(a.b*)...(a.b*) de 10000 positions.
+		Rationnel * expression = NULL;
+		int i;
+		for( i = 0; i < 5000; i++ ){
+			Rationnel * facteur = Concat( Lettre( 'a' ), Star( Lettre( 'b' ) ) );
+			expression = expression ? Concat( expression, facteur ) : facteur;
+		}
+		Automate * automate = Glushkov( expression );
+
+		TEST( 
+			1
+			&& taille_ensemble( get_etats( automate ) ) == 10001
+			&& nombre_de_transitions( automate ) == 4 * 5000 - 1
+			&& est_un_etat_final_de_l_automate( automate, 10000 )
+			&& est_un_etat_final_de_l_automate( automate, 9999 )
+			&& ! est_un_etat_final_de_l_automate( automate, 9998 )
+			, result
+		);
+
+		liberer_automate( automate );
+	}
+
 	return result;
 }
 
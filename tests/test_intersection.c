@@ -0,0 +1,106 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "automate.h"
+#include "rationnel.h"
+#include "outils.h"
+
+#include <string.h>
+
+int test_intersection(){
+	int result = 1;
+
+	{
+		Automate* a1 = Glushkov( expression_to_rationnel( "(a+b)*.a.(a+b)*" ) );
+		Automate* a2 = Glushkov( expression_to_rationnel( "(a.a+b)*" ) );
+		Automate* inter = creer_intersection_des_automates( a1, a2 );
+
+		// Tous les mots de longueur au plus 8 sur {a, b}.
+		char mot[9];
+		int longueur, code, i, correct = 1;
+		for( longueur = 0; longueur <= 8; longueur++ ){
+			for( code = 0; code < ( 1 << longueur ); code++ ){
+				for( i = 0; i < longueur; i++ ){
+					mot[i] = ( code >> i ) & 1 ? 'b' : 'a';
+				}
+				mot[longueur] = '\0';
+				correct &= le_mot_est_reconnu( inter, mot ) == (
+					le_mot_est_reconnu( a1, mot ) && le_mot_est_reconnu( a2, mot )
+				);
+			}
+		}
+
+		TEST(
+			1
+			&& correct
+			&& est_un_etat_initial_de_l_automate( inter, 0 )
+			&& taille_ensemble( get_etats( inter ) ) 
+				<= taille_ensemble( get_etats( a1 ) ) * taille_ensemble( get_etats( a2 ) )
+			, result
+		);
+		liberer_automate( a1 );
+		liberer_automate( a2 );
+		liberer_automate( inter );
+	}
+
+	{
+		// Deux cycles de 5000 états : seuls les 5000 couples (i, i) sont
+		// accessibles, parmi les 25 millions.
+		int n = 5000, i;
+		Automate* a1 = creer_automate();
+		Automate* a2 = creer_automate();
+		for( i = 0; i < n; i++ ){
+			ajouter_transition( a1, i, 'a', ( i + 1 ) % n );
+			ajouter_transition( a1, i, 'b', i );
+			ajouter_transition( a2, i, 'a', ( i + 1 ) % n );
+		}
+		ajouter_etat_initial( a1, 0 );
+		ajouter_etat_initial( a2, 0 );
+		ajouter_etat_final( a1, n - 1 );
+		ajouter_etat_final( a2, n - 1 );
+		Automate* inter = creer_intersection_des_automates( a1, a2 );
+
+		char* mot = xmalloc( 2 * n );
+		memset( mot, 'a', n - 1 );
+		mot[n-1] = '\0';
+
+		TEST(
+			1
+			&& taille_ensemble( get_etats( inter ) ) == n
+			&& taille_ensemble( get_finaux( inter ) ) == 1
+			&& nombre_de_transitions( inter ) == n
+			&& le_mot_est_reconnu( inter, mot )
+			, result
+		);
+		xfree( mot );
+		liberer_automate( a1 );
+		liberer_automate( a2 );
+		liberer_automate( inter );
+	}
+
+	return result;
+}
+
+int main(){
+
+	if( ! test_intersection() ){ return 1; }
+
+	return 0;
+}
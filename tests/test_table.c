@@ -0,0 +1,133 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "table.h"
+#include "reserve.h"
+#include "outils.h"
+
+#include <stdlib.h>
+
+int comparer_pointe( const intptr_t a, const intptr_t b ){
+	return *(int*) a - *(int*) b;
+}
+
+intptr_t copier_pointe( const intptr_t a ){
+	int* res = xmalloc( sizeof(int) );
+	*res = *(int*) a;
+	return (intptr_t) res;
+}
+
+void supprimer_pointe( intptr_t a ){
+	xfree( (int*) a );
+}
+
+int test_table(){
+	int result = 1;
+
+	{
+		// Les clés sont copiées par la table.
+		Table * table = creer_table( comparer_pointe, copier_pointe, supprimer_pointe );
+		int i, cle;
+		for( i = 0; i < 1000; i++ ){
+			cle = i % 500;
+			add_table( table, (intptr_t) &cle, i );
+		}
+		cle = 7;
+		int trouve = get_valeur( trouver_table( table, (intptr_t) &cle ) ) == 507;
+		int valeur = delete_table( table, (intptr_t) &cle );
+		int absent = iterateur_est_vide( trouver_table( table, (intptr_t) &cle ) );
+		cle = 1000;
+		int rien = delete_table( table, (intptr_t) &cle ) == 0;
+
+		int ordonne = 1, precedent = -1;
+		Table_iterateur it;
+		for(
+			it = premier_iterateur_table( table );
+			! iterateur_est_vide( it );
+			it = iterateur_suivant_table( it )
+		){
+			int c = *(int*) get_cle( it );
+			ordonne &= c > precedent && get_valeur( it ) == c + 500;
+			precedent = c;
+		}
+
+		TEST(
+			1
+			&& trouve
+			&& valeur == 507
+			&& absent
+			&& rien
+			&& ordonne
+			&& taille_table( table ) == 499
+			, result
+		);
+
+		// Les noeuds libérés sont réutilisés.
+		vider_table( table );
+		size_t avant = nombre_allocations();
+		for( i = 0; i < 100; i++ ){
+			cle = i;
+			add_table( table, (intptr_t) &cle, i );
+		}
+
+		TEST(
+			1
+			&& taille_table( table ) == 100
+			&& nombre_allocations() - avant == 100
+			, result
+		);
+		liberer_table( table );
+	}
+
+	{
+		// Sans réserve, chaque noeud est alloué par xmalloc().
+		size_t allocations[2];
+		int directe;
+		for( directe = 0; directe < 2; directe++ ){
+			utiliser_reserves_directes( directe );
+			size_t avant = nombre_allocations();
+			Table * table = creer_table( comparer_pointe, copier_pointe, supprimer_pointe );
+			int i, cle;
+			for( i = 0; i < 100; i++ ){
+				cle = i;
+				add_table( table, (intptr_t) &cle, i );
+			}
+			delete_table( table, (intptr_t) &cle );
+			allocations[directe] = nombre_allocations() - avant;
+			liberer_table( table );
+		}
+		utiliser_reserves_directes( 0 );
+
+		TEST(
+			1
+			&& allocations[1] >= allocations[0] + 90
+			, result
+		);
+	}
+
+	return result;
+}
+
+int main(){
+
+	if( ! test_table() ){ return 1; }
+
+	return 0;
+}